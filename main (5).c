@@ -10,11 +10,33 @@
 // Author: 11937605
 //------------------------------------------------------------------------------
 //
+// epoll, memory mapping, memory streams and nanosecond file times are
+// no part of ISO C, so the extensions are enabled for every header
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <errno.h>
+#include <math.h>
 #include "framework.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #define ALLOWED_ARGUMENTS 2
 #define SUCCESS 0
 #define WRONG_ARGUMENTS_NR 1
@@ -22,11 +44,688 @@
 #define INVALID_CONFIG_FILE 3
 #define OUT_MEMORY_ERROR 4
 
+#define SEGMENT_VECTOR_SIZE 32
+#define FIELD_LINE_BUFFER (2 * SEGMENT_VECTOR_SIZE)
+#define SEGMENT_CONFLICT 1
+#define SEGMENT_OVERLAP 2
+#define SEGMENT_EMPTY 4
+
+#define MIN_FIELD_SIZE 4
+#define MAX_FIELD_SIZE 26
+#define MAX_SPARSE_FIELD_SIZE 1024
+#define MAX_COORDINATE_LENGTH 3
+#define FIELD_CHUNK_SIZE 16
+#define FIELD_CHUNK_CELLS (FIELD_CHUNK_SIZE * FIELD_CHUNK_SIZE)
+#define FIELD_SEGMENT_BUFFER (MAX_SPARSE_FIELD_SIZE + SEGMENT_VECTOR_SIZE)
+#define PRINT_WINDOW_SIZE 64
+#define ALPHABET_SIZE 26
+
+#define DELTA_RING_SIZE (1 << 18)
+#define DELTA_RECORD_ALIGN 8
+#define DELTA_HEADER_SIZE 20
+#define DELTA_CELL_SIZE 5
+#define DELTA_SNAPSHOT_INTERVAL 32
+#define DELTA_RECORD_NONE 0
+#define DELTA_RECORD_MOVE 1
+#define DELTA_RECORD_SNAPSHOT 2
+#define DELTA_RECORD_WRAP 3
+#define DELTA_RECORD_SNAPSHOT_PART 4
+#define DELTA_RECORD_GAME_END 5
+#define DELTA_STREAM_MAGIC "A3DELTA1"
+#define DELTA_STREAM_MAGIC_SIZE 8
+#define DELTA_STREAM_HEADER_SIZE 64
+#define DELTA_STREAM_SUFFIX ".deltas"
+#define DELTA_WATCH_POLL_MICROSECONDS 20000
+
+#define BINARY_LENGTH_SIZE 4
+#define BINARY_FRAME_SIZE (8 + MAX_SPARSE_FIELD_SIZE)
+#define BINARY_INSERT_HEADER_SIZE 5
+#define BINARY_RESPONSE_HEADER_SIZE 16
+#define BINARY_BOARD_HEADER_SIZE 6
+#define BINARY_NONE 0
+#define BINARY_INSERT 1
+#define BINARY_SAVE 2
+#define BINARY_QUERY_BOARD 3
+#define BINARY_QUERY_SCORES 4
+#define BINARY_QUIT 5
+#define BINARY_STATUS_OK 0
+#define BINARY_STATUS_IMPOSSIBLE 1
+#define BINARY_STATUS_INVALID 2
+#define BINARY_STATUS_SAVE_FAILED 3
+#define BINARY_STATUS_UNKNOWN 4
+#define BINARY_STATUS_NO_MEMORY 5
+
+#define PACKED_HEADER_SIZE 13
+#define PACKED_LETTER_BITS 5
+#define PACKED_BENCHMARK_POSITIONS 100000
+
+#define MOVE_WORD_SIZE 32
+#define FIND_PRINT_LIMIT 20
+#define DICTIONARY_NAME "dictionary.txt"
+#define RACK_MAX_SIZE 12
+#define HINT_DEFAULT_MOVES 3
+#define HINT_LINE_MOVES 20
+#define HINT_LINE_CANDIDATES 40
+#define HINT_CACHE_SLOTS 2
+#define HINT_DEADLINE_MS 50
+#define SEARCH_CLOCK_INTERVAL 1024
+
+#define TOURNAMENT_NAME_SIZE 32
+#define TOURNAMENT_RATING_ROUNDS 1000
+#define TOURNAMENT_GREEDY 0
+#define TOURNAMENT_TOP 1
+#define TOURNAMENT_DEADLINE 2
+#define TOURNAMENT_BOOK_SUFFIX "+book"
+#define SESSION_EVENTS 64
+#define SESSION_READ_SIZE 4096
+#define ARCHIVE_MAGIC "A3ARCH01"
+#define ARCHIVE_MAGIC_SIZE 8
+#define ARCHIVE_BLOCK_GAMES 1024
+#define ARCHIVE_COLUMN_COUNT 13
+#define ARCHIVE_BLOCK_HEADER_SIZE (8 + 4 * ARCHIVE_COLUMN_COUNT)
+#define ARCHIVE_LETTERS 0
+#define ARCHIVE_START 1
+#define ARCHIVE_FIELD_SIZE 2
+#define ARCHIVE_MOVE_COUNT 3
+#define ARCHIVE_FINAL_POINTS 4
+#define ARCHIVE_WINNER 5
+#define ARCHIVE_MOVE_ROWS 6
+#define ARCHIVE_MOVE_COLUMNS 7
+#define ARCHIVE_ORIENTATIONS 8
+#define ARCHIVE_PLAYERS 9
+#define ARCHIVE_MOVE_POINTS 10
+#define ARCHIVE_WORD_LETTERS 11
+#define ARCHIVE_WORD_SIZES 12
+#define TOURNAMENT_CSV 0
+#define TOURNAMENT_JSON 1
+#define TOURNAMENT_ARCHIVE 2
+#define CORPUS_LETTERS_SIZE 256
+#define MONTE_CARLO_CANDIDATES 5
+#define MONTE_CARLO_MAX_CANDIDATES 64
+#define MONTE_CARLO_SIMULATIONS 200
+#define MONTE_CARLO_ROLLOUT_MOVES 3
+#define MONTE_CARLO_DEPTH 128
+#define ANAGRAM_KEY_SEED 0x9e3779b97f4a7c15ULL
+
+#define BOOK_MAGIC "A3BOOK01"
+#define BOOK_MAGIC_SIZE 8
+#define BOOK_HEADER_SIZE 16
+#define BOOK_ENTRY_SIZE 48
+#define BOOK_WORD_SIZE 32
+#define BOOK_LINE_DEPTH 8
+#define OPENING_BOOK_NAME "opening.book"
+#define DICTIONARY_IMAGE_MAGIC "A3DICT02"
+#define DICTIONARY_IMAGE_MAGIC_SIZE 8
+#define DICTIONARY_IMAGE_HEADER_SIZE 48
+#define DICTIONARY_IMAGE_SECTIONS 7
+#define DICTIONARY_IMAGE_ALIGN 8
+#define DICTIONARY_IMAGE_SUFFIX ".image"
+
+#if defined(__GNUC__)
+#define BOARD_KERNEL_INLINE static inline __attribute__((always_inline))
+#else
+#define BOARD_KERNEL_INLINE static inline
+#endif
+
 typedef struct _Word_ {
   char letter_;
   int letter_points_;
 } Word;
 
+// letters of the char points string, counted once instead of parsing the
+// string for every letter
+typedef struct _LetterTable_ {
+  int counts_[ALPHABET_SIZE];
+  int points_[ALPHABET_SIZE];
+} LetterTable;
+
+// candidate inserts as structure of arrays, the words are stored one after
+// another in words_. results_ and scores_ are filled by validateInsertBatch.
+typedef struct _InsertBatch_ {
+  int count_;
+  const int* rows_;
+  const int* columns_;
+  const int* orientations_;
+  const int* word_offsets_;
+  const int* word_sizes_;
+  const char* words_;
+  int* results_;
+  int* scores_;
+} InsertBatch;
+
+// letters of the field and the game state at the moment of a save. The
+// letters are copied per chunk, free chunks of large fields stay NULL. The
+// char points string and config name are not copied, they do not change
+// while the game runs.
+typedef struct _SaveSnapshot_ {
+  int field_size_;
+  int chunks_per_line_;
+  char** chunks_;
+  int player1_points_;
+  int player2_points_;
+  int player_turn_;
+  const char* char_points_string_;
+  const char* config_name_;
+} SaveSnapshot;
+
+// background thread writing save snapshots. A snapshot which was not
+// picked up yet is replaced by a newer one, so saves arriving back to back
+// are written once.
+typedef struct _SaveWriter_ {
+  pthread_t thread_;
+  pthread_mutex_t mutex_;
+  pthread_cond_t condition_;
+  int started_;
+  int stop_;
+  SaveSnapshot* pending_;
+  unsigned long submitted_saves_;
+  unsigned long durable_saves_;
+  int save_error_;
+} SaveWriter;
+
+// per move deltas for spectators in one ring buffer inside a shared file
+// mapping. Every viewer maps the file and reads the same encoded bytes in
+// place. A record is, little endian:
+//   u32 record size, u8 type, u8 player, u16 cell count,
+//   u32 points player 1, u32 points player 2, u32 game,
+//   cell count times (u16 row, u16 column, u8 letter),
+// padded to DELTA_RECORD_ALIGN. Move records hold the cells of the word and
+// the player who moved, a snapshot record and the snapshot part records
+// right behind it hold every letter on the field of a game and the player
+// to move. A wrap record only has a size and type and fills the rest of the
+// ring. Positions count all bytes ever written. The file starts with the
+// header, the ring follows at DELTA_STREAM_HEADER_SIZE.
+typedef struct _DeltaStreamHeader_ {
+  char magic_[DELTA_STREAM_MAGIC_SIZE];
+  unsigned long long ring_size_;
+  atomic_ullong write_position_;
+  atomic_ullong snapshot_position_;
+  atomic_int finished_;
+} DeltaStreamHeader;
+
+// a mapped delta stream. Several games may write to it, one at a time
+typedef struct _DeltaStream_ {
+  DeltaStreamHeader* header_;
+  unsigned char* ring_;
+  unsigned long long ring_size_;
+  size_t map_size_;
+  int writer_;
+  pthread_mutex_t write_mutex_;
+} DeltaStream;
+
+// a game writing to a delta stream
+typedef struct _DeltaGame_ {
+  unsigned int game_;
+  int moves_since_snapshot_;
+  int bytes_since_snapshot_;
+} DeltaGame;
+
+typedef struct _DeltaSubscriber_ {
+  unsigned long long read_position_;
+  unsigned long long record_position_;
+} DeltaSubscriber;
+
+// board storage and operations for one field size, selected once at load.
+// Fields up to MAX_FIELD_SIZE are arrays of rows with kernels specialized on
+// the size. Larger fields are a directory of FIELD_CHUNK_SIZE square chunks,
+// a chunk is only allocated when the first letter is written to it.
+typedef struct _BoardKernels_ {
+  int field_size_;
+  Word** (*create_field_)(int field_size);
+  void (*free_field_)(Word** game_play_field, int field_size);
+  Word* (*cell_)(Word** game_play_field, int field_size, int row, int column,
+                 int allocate);
+  int (*check_empty_)(Word** game_play_field, int field_size);
+  void (*load_line_)(Word** game_play_field, int field_size, int line_index,
+                     int orientation, char* field_line);
+  void (*load_segment_)(Word** game_play_field, int field_size, int row,
+                        int column, int orientation, int length,
+                        char* segment);
+  void (*print_field_)(Word** game_play_field, int field_size);
+} BoardKernels;
+
+// words of a word list file, one word per line. The words are stored one
+// after another in words_, each ending with eos.
+typedef struct _WordList_ {
+  char* words_;
+  int* offsets_;
+  int* sizes_;
+  int count_;
+} WordList;
+
+// one placement of a word, as found by the move searches
+typedef struct _FieldMove_ {
+  int row_;
+  int column_;
+  int orientation_;
+  int points_;
+  char word_[MOVE_WORD_SIZE];
+} FieldMove;
+
+// dictionary as a trie. The children of a node are stored one after
+// another in letter order, starting at first_child_. Bit l of child_mask_
+// is set if there is a child for letter 'a' + l, so the child is found by
+// counting the lower bits. Node 0 is the root. longest_suffix_ is the
+// number of letters the longest word below the node still has. Only
+// indices are stored, so the nodes can be used from wherever they are in
+// memory.
+typedef struct _DictionaryNode_ {
+  unsigned int child_mask_;
+  int first_child_;
+  int parent_;
+  unsigned char letter_;
+  unsigned char word_end_;
+  unsigned short longest_suffix_;
+} DictionaryNode;
+
+// anchor_nodes_ lists the nodes by depth and letter, the nodes of depth d
+// reached with letter l start at anchor_offsets_[(d - 1) * ALPHABET_SIZE +
+// l]. A word whose letter d - 1 has to be a given letter on the field is
+// started from these nodes instead of walking every shorter prefix.
+// anagram_nodes_ lists the word end nodes grouped by their letters, class c
+// starting at anagram_offsets_[c]. anagram_keys_[c] is the sum of
+// anagramLetterKey over the letters of the class, it is found through
+// anagram_slots_, which hold class + 1 (0 for free) and are probed linearly
+// from key & (slot count - 1).
+// A dictionary mapped from an image (image_ not NULL) points into the map
+// and must not be changed. The image is
+//   DICTIONARY_IMAGE_MAGIC, u32 size of a node, u32 node count, u32 word
+//   count, u32 max word size, u32 anagram class count, u32 anagram slot
+//   count, u64 size and u64 change time in nanoseconds of the word list,
+//   then the arrays
+//   in the order of the struct, as in memory, each starting at a multiple
+//   of DICTIONARY_IMAGE_ALIGN.
+typedef struct _Dictionary_ {
+  DictionaryNode* nodes_;
+  int* anchor_offsets_;
+  int* anchor_nodes_;
+  int* anagram_nodes_;
+  int* anagram_offsets_;
+  int* anagram_slots_;
+  unsigned long long* anagram_keys_;
+  int anagram_class_count_;
+  int anagram_slot_count_;
+  int node_count_;
+  int word_count_;
+  int max_word_size_;
+  const unsigned char* image_;
+  size_t image_size_;
+} Dictionary;
+
+// state of a find query while the dictionary is walked along one line.
+// The pattern is matched with one bit per pattern position, bit p meaning
+// the first p pattern characters are matched. letters_left_ counts the
+// letters which may still go on free cells, a letter leaves
+// available_letters_ when it runs out. With a move_limit_ only that many
+// best moves are kept, and with a deadline_ (0 for none) the walk stops
+// once the clock passes it.
+typedef struct _PatternSearch_ {
+  const Dictionary* dictionary_;
+  const LetterTable* letter_table_;
+  const char* field_line_;
+  const int* next_letter_;
+  int line_size_;
+  int line_index_;
+  int orientation_;
+  int start_;
+  int field_empty_;
+  unsigned int available_letters_;
+  int letters_left_[ALPHABET_SIZE];
+  unsigned int start_states_;
+  int pattern_size_;
+  unsigned int pattern_letters_[SEGMENT_VECTOR_SIZE];
+  unsigned int pattern_repeats_;
+  char word_[MOVE_WORD_SIZE];
+  FieldMove* moves_;
+  int move_count_;
+  int move_capacity_;
+  int move_limit_;
+  int worst_move_;
+  double deadline_;
+  unsigned int clock_counter_;
+  int timed_out_;
+} PatternSearch;
+
+// a dictionary word with its letters sorted, while the anagram classes are
+// built
+typedef struct _AnagramEntry_ {
+  char signature_[MOVE_WORD_SIZE];
+  int node_;
+} AnagramEntry;
+
+// state of a rack query. Every letter count from 0 up to letter_limits_ is
+// tried, fixed_letter_ (-1 for none) only with its limit, and every set of
+// counts is looked up in the anagram index. The words found are placed
+// where the field holds one of their letters.
+typedef struct _RackSearch_ {
+  const Dictionary* dictionary_;
+  Word** game_play_field_;
+  const BoardKernels* board_kernels_;
+  const LetterTable* letter_table_;
+  unsigned long long letter_keys_[ALPHABET_SIZE];
+  int rack_counts_[ALPHABET_SIZE];
+  int letter_limits_[ALPHABET_SIZE];
+  int letter_counts_[ALPHABET_SIZE];
+  int fixed_letter_;
+  int field_empty_;
+  int* letter_cells_;
+  int letter_offsets_[ALPHABET_SIZE + 1];
+  int* classes_;
+  int class_count_;
+  int class_capacity_;
+  FieldMove* moves_;
+  int move_count_;
+  int move_capacity_;
+} RackSearch;
+
+// opening book file, built by --build-book and mapped read only. Little
+// endian:
+//   BOOK_MAGIC, u32 slot count (a power of two), u32 entry count,
+//   slot count times BOOK_ENTRY_SIZE bytes: u64 position hash (0 for a free
+//   slot), u16 row, u16 column, u8 orientation, u8 word size, u16 points,
+//   word letters padded with eos to BOOK_WORD_SIZE.
+// A position is looked up by linear probing from hash & (slot count - 1).
+typedef struct _OpeningBook_ {
+  const unsigned char* map_;
+  size_t map_size_;
+  unsigned int slot_count_;
+  unsigned int entry_count_;
+} OpeningBook;
+
+// moves of a slot of the hint cache, found so far on every line for a
+// rack holding the letters of rack_, or for any letters if rack_ is empty.
+// Line l, row l for l < field size and column l - field size otherwise,
+// keeps counts_[l] moves from HINT_LINE_CANDIDATES * l on, sorted by
+// compareFieldMoves. starts_ counts the first cells of words searched so
+// far on a line, a line cut off by the deadline goes on from there.
+typedef struct _HintLines_ {
+  FieldMove* moves_;
+  int* counts_;
+  int* starts_;
+  char rack_[RACK_MAX_SIZE + 1];
+  unsigned long last_used_;
+} HintLines;
+
+// best moves of every line for the hint command. A move lies on one line
+// and only depends on its cells, so an insert only makes the lines through
+// its new letters stale. The moves a rack can play are the first moves of
+// a line searched for more letters which it holds, so a rack is served
+// from any slot searched for all of its letters and filters them, like the
+// rack left after an insert of its player. Each player keeps a slot, so
+// the two racks do not evict each other. The moves were searched on a
+// field which was empty or not.
+typedef struct _HintCache_ {
+  HintLines slots_[HINT_CACHE_SLOTS];
+  unsigned long hint_count_;
+  int line_count_;
+  int field_empty_;
+} HintCache;
+
+// archive of finished games for analytics: ARCHIVE_MAGIC, then blocks of
+// up to ARCHIVE_BLOCK_GAMES games, each column of a block stored on its own
+// (see flushArchiveBlock). Columns ARCHIVE_LETTERS to ARCHIVE_WINNER have
+// one value per game, the others one per move, in the order of the games.
+// Numbers are varints (putArchiveVarint). The letters and the packed start
+// position (see encodePackedPosition) are a varint size and the bytes, the
+// final points two numbers. Orientations (1 for vertical) and players (1
+// for player 2) are one bit per move, the words PACKED_LETTER_BITS per
+// letter, their sizes being in ARCHIVE_WORD_SIZES.
+typedef struct _ArchiveColumn_ {
+  unsigned char* bytes_;
+  size_t size_;
+  size_t capacity_;
+  size_t bit_count_;
+} ArchiveColumn;
+
+// the block being built for an archive
+typedef struct _ArchiveWriter_ {
+  FILE* file_;
+  ArchiveColumn columns_[ARCHIVE_COLUMN_COUNT];
+  int game_count_;
+  int move_count_;
+} ArchiveWriter;
+
+// a finished game for the archive, move_players_[m] made moves_[m]
+typedef struct _ArchiveGame_ {
+  const char* char_points_string_;
+  int field_size_;
+  const unsigned char* packed_;
+  int packed_size_;
+  FieldMove* moves_;
+  int* move_players_;
+  int move_count_;
+  int move_capacity_;
+  int player1_points_;
+  int player2_points_;
+} ArchiveGame;
+
+// an archive mapped for reading, position_ being the next block
+typedef struct _ArchiveReader_ {
+  const unsigned char* map_;
+  size_t map_size_;
+  size_t position_;
+} ArchiveReader;
+
+// the columns of one block, pointing into the map of the reader
+typedef struct _ArchiveBlock_ {
+  int game_count_;
+  int move_count_;
+  const unsigned char* columns_[ARCHIVE_COLUMN_COUNT];
+  size_t column_sizes_[ARCHIVE_COLUMN_COUNT];
+} ArchiveBlock;
+
+// read position in a column, in bytes or, for columns of bits, in bits
+typedef struct _ArchiveCursor_ {
+  const unsigned char* bytes_;
+  size_t size_;
+  size_t position_;
+} ArchiveCursor;
+
+// aggregates of the corpus analysis, one per thread and merged at the end.
+// heatmaps_[s] counts for every cell of a field of size s in how many
+// final positions it is occupied, allocated for the sizes seen.
+typedef struct _CorpusStats_ {
+  long* heatmaps_[MAX_SPARSE_FIELD_SIZE + 1];
+  long heatmap_positions_[MAX_SPARSE_FIELD_SIZE + 1];
+  long letter_counts_[ALPHABET_SIZE];
+  long letter_points_[ALPHABET_SIZE];
+  long archived_games_;
+  long saved_positions_;
+  long unreadable_files_;
+  long game_moves_;
+  long moves_;
+  long rejected_moves_;
+  long move_points_;
+  long longest_game_;
+} CorpusStats;
+
+// one piece of work of the corpus analysis, a block of an archive or a
+// saved config
+typedef struct _CorpusWork_ {
+  int file_index_;
+  int is_archive_;
+  ArchiveBlock archive_block_;
+} CorpusWork;
+
+// files and work of the corpus analysis, readers_ keeps the archives
+// mapped until all threads are done
+typedef struct _Corpus_ {
+  char** file_names_;
+  ArchiveReader* readers_;
+  CorpusWork* work_;
+  int work_count_;
+  atomic_int next_work_;
+  atomic_int error_;
+} Corpus;
+
+// a thread of the corpus analysis with its own aggregates
+typedef struct _CorpusThread_ {
+  pthread_t thread_;
+  Corpus* corpus_;
+  CorpusStats corpus_stats_;
+  int error_file_;
+} CorpusThread;
+
+// automatic player of a tournament: "greedy" plays the best move, "top<n>"
+// a random one of the n best moves and "deadline<ms>" the best move found
+// within ms milliseconds. With TOURNAMENT_BOOK_SUFFIX appended the player
+// plays the book move of a position in the opening book instead.
+typedef struct _TournamentPlayer_ {
+  char name_[TOURNAMENT_NAME_SIZE];
+  int strategy_;
+  int parameter_;
+  int book_;
+} TournamentPlayer;
+
+// start position of a tournament config, read once and packed
+typedef struct _TournamentBoard_ {
+  char* config_name_;
+  char* char_points_string_;
+  BoardKernels board_kernels_;
+  LetterTable letter_table_;
+  unsigned char* packed_;
+  int packed_size_;
+} TournamentBoard;
+
+// one game of a tournament, first_ playing for player 1 of the config
+typedef struct _TournamentGame_ {
+  int board_;
+  int first_;
+  int second_;
+  int first_points_;
+  int second_points_;
+  int move_count_;
+} TournamentGame;
+
+// everything the tournament threads share. A thread takes the game at
+// next_game_ and writes its result to its place in games_, so only the
+// result file needs a lock.
+typedef struct _Tournament_ {
+  TournamentBoard* boards_;
+  int board_count_;
+  TournamentPlayer* players_;
+  int player_count_;
+  Dictionary dictionary_;
+  OpeningBook opening_book_;
+  TournamentGame* games_;
+  int game_count_;
+  atomic_int next_game_;
+  atomic_int error_;
+  FILE* sink_;
+  ArchiveWriter archive_writer_;
+  int sink_format_;
+  pthread_mutex_t sink_mutex_;
+  DeltaStream delta_stream_;
+} Tournament;
+
+// the cells one move filled, to take the move back
+typedef struct _MoveUndo_ {
+  int rows_[MOVE_WORD_SIZE];
+  int columns_[MOVE_WORD_SIZE];
+  int count_;
+} MoveUndo;
+
+// everything the simulation threads share. A thread takes the simulation
+// at next_simulation_, simulation i plays candidate i % candidate_count_.
+typedef struct _MonteCarlo_ {
+  const TournamentBoard* board_;
+  const Dictionary* dictionary_;
+  const FieldMove* candidates_;
+  int candidate_count_;
+  int simulations_;
+  int player1_points_;
+  int player2_points_;
+  int player_turn_;
+  int winning_points_;
+  atomic_int next_simulation_;
+  atomic_int error_;
+} MonteCarlo;
+
+// a simulation thread with its own field, undo stack and sums per
+// candidate
+typedef struct _MonteCarloThread_ {
+  pthread_t thread_;
+  MonteCarlo* monte_carlo_;
+  Word** game_play_field_;
+  MoveUndo move_undos_[MONTE_CARLO_DEPTH];
+  long* margin_sums_;
+  long* wins_;
+  long simulations_;
+  long rollout_moves_;
+} MonteCarloThread;
+
+// a candidate with the result of its simulations
+typedef struct _MonteCarloMove_ {
+  FieldMove field_move_;
+  double average_margin_;
+  double win_share_;
+} MonteCarloMove;
+
+// everything a running game needs, shared by the text and binary commands
+typedef struct _GameState_ {
+  Word** game_play_field_;
+  BoardKernels board_kernels_;
+  LetterTable letter_table_;
+  SaveWriter save_writer_;
+  OpeningBook opening_book_;
+  Dictionary dictionary_;
+  int dictionary_shared_;
+  char racks_[2][RACK_MAX_SIZE + 1];
+  HintCache hint_cache_;
+  DeltaStream* delta_stream_;
+  DeltaGame delta_game_;
+  char* char_points_string_;
+  char* config_name_;
+  int player1_points_;
+  int player2_points_;
+  int player_turn_;
+  int winning_points_;
+} GameState;
+
+// text game as a state machine: every line fed to it runs as a command and
+// prints the next prompt, so it never waits for input itself
+typedef struct _GameSession_ {
+  GameState* game_state_;
+  FILE* binary_input_;
+  FILE* binary_output_;
+  char* line_;
+  int line_size_;
+  int line_capacity_;
+  int printing_check_;
+  int running_;
+  int memory_error_;
+  int save_refused_;
+} GameSession;
+
+// a game served to one connection by the session scheduler
+// Output waits in output_buffer_ until the connection takes it.
+typedef struct _ServedSession_ {
+  GameState game_state_;
+  GameSession game_session_;
+  int socket_;
+  FILE* output_;
+  char* output_buffer_;
+  size_t output_size_;
+  size_t output_sent_;
+} ServedSession;
+
+// binary commands for bots, entered with the text command "binary" and used
+// until the game ends. Every frame is, little endian: u32 size of the rest
+// of the frame, u8 command, payload. BINARY_INSERT has the payload
+//   u16 row, u16 column, u8 orientation, word letters,
+// the other commands have none. Every response starts with
+//   u32 size of the rest, u8 command, u8 status, u8 player to move,
+//   u8 winner or 0, u32 points player 1, u32 points player 2.
+// status is one of the BINARY_STATUS_ numbers, see binaryStatus.
+// BINARY_INSERT adds u32 points won, BINARY_QUERY_BOARD adds u16 field size,
+// u32 cell count and cell count times (u16 row, u16 column, u8 letter).
+
+// packed positions, to keep millions of them in memory. Little endian:
+//   u32 points player 1, u32 points player 2, u8 player to move,
+//   u32 letter count, one occupancy bit per cell row by row,
+//   PACKED_LETTER_BITS per occupied cell (letter - 'a') in the same order.
+// The letter points are not stored, they come from the letter table.
+
 // forward declarations
 char** getConfigContent(FILE* config_text, int* return_value,
                         char** char_points_string,
@@ -36,30 +735,355 @@ char* getLetterPoints(FILE* config_text);
 int charToDecimal(FILE* config_text);
 char** configToArray(FILE* config_text, int* return_value,
                      int* field_size, int* player_turn);
-void gamePlayStart(char** file_elements_array, char* char_points_string,
-                   int player1_points,
-                   int player2_points, int field_size, int player_turn,
-                   int* memory_error, char *config_name);
+void gamePlayStart(GameState* game_state, int* memory_error);
+void initializeGameSession(GameSession* game_session, GameState* game_state,
+                           FILE* binary_input, FILE* binary_output);
+void gameSessionPrompt(GameSession* game_session);
+void gameSessionCommand(GameSession* game_session, char* game_input);
+int feedGameSession(GameSession* game_session, const char* input,
+                    int input_size);
+void endGameSessionInput(GameSession* game_session);
 void printHelpCommand();
 char* gamePlayInput();
 Word** initializeGameField(char** file_elements_array,
-                           char* char_points_string, int field_size);
+                           char* char_points_string,
+                           const BoardKernels* board_kernels);
 void printLetterPlayerPoints(char* char_points_string, int player1_points,
                              int player2_points);
 void gameProgressPrint(Word** game_play_field, char* char_points_string,
-                       int field_size, int player1_points, int player2_points);
-int gamePlaySaveCommand(char* config_name, Word** game_play_field,
-                        char* char_points_string, int field_size,
-                        int player1_points, int player2_points,
-                        int player_turn);
-int checkWordInput(Input* player_input, const char* char_points_string);
-int checkEmptyField(Word** game_play_field, int field_size);
-int wordPlacementCheck(Word** game_play_field, Input* player_input,
-                       char* char_points_string, int field_size);
-int pointLetterInput(char word_char, const char* char_points_string);
-int gamePlayInsertCommand(Word** game_play_field, Input* player_input,
-                          char* char_points_string, int field_size,
-                          int* points_won);
+                       const BoardKernels* board_kernels, int player1_points,
+                       int player2_points);
+int checkWordInput(const char* word, int word_size,
+                   const LetterTable* letter_table);
+BOARD_KERNEL_INLINE int checkEmptyField(Word** game_play_field,
+                                        int field_size);
+BOARD_KERNEL_INLINE void loadFieldLine(Word** game_play_field, int field_size,
+                                       int line_index, int orientation,
+                                       char* field_line);
+unsigned int segmentCharMask(const char* segment, char letter);
+int segmentMatchCheck(const char* segment, const char* word, int word_size);
+void segmentMatchAllOffsets(const char* field_line, int line_size,
+                            const char* word, int word_size,
+                            unsigned int* conflict_starts,
+                            unsigned int* overlap_starts,
+                            unsigned int* occupied_starts);
+BOARD_KERNEL_INLINE void printGameField(Word** game_play_field,
+                                        int field_size);
+void getBoardKernels(int field_size, BoardKernels* board_kernels);
+int fieldPlacementCheck(Word** game_play_field,
+                        const BoardKernels* board_kernels, int row,
+                        int column, int orientation, const char* word,
+                        int word_size, const LetterTable* letter_table);
+int fieldInsertWord(Word** game_play_field, const BoardKernels* board_kernels,
+                    int row, int column, int orientation, const char* word,
+                    int word_size, const LetterTable* letter_table,
+                    int* points_won);
+void buildLetterTable(const char* char_points_string,
+                      LetterTable* letter_table);
+int placementParameterCheck(int field_size, int row, int column,
+                            int orientation, const char* word, int word_size,
+                            const LetterTable* letter_table);
+int validateInsertBatch(Word** game_play_field,
+                        const BoardKernels* board_kernels,
+                        const LetterTable* letter_table,
+                        InsertBatch* insert_batch);
+int recheckFieldMoves(Word** game_play_field,
+                      const BoardKernels* board_kernels,
+                      const LetterTable* letter_table, FieldMove* moves,
+                      int* move_count);
+int compareBatchKeys(const void* first_key, const void* second_key);
+SaveSnapshot* createSaveSnapshot(Word** game_play_field,
+                                 const BoardKernels* board_kernels,
+                                 const char* char_points_string,
+                                 const char* config_name, int player1_points,
+                                 int player2_points, int player_turn);
+void freeSaveSnapshot(SaveSnapshot* save_snapshot);
+int writeSaveSnapshot(const SaveSnapshot* save_snapshot);
+void initializeSaveWriter(SaveWriter* save_writer);
+int submitSaveSnapshot(SaveWriter* save_writer, SaveSnapshot* save_snapshot);
+void* saveWriterThread(void* writer_argument);
+int saveWriterDurable(SaveWriter* save_writer, unsigned long* pending_saves,
+                      unsigned long* durable_saves);
+void printSaveStatus(GameState* game_state);
+int takeSaveWriterError(SaveWriter* save_writer);
+int stopSaveWriter(SaveWriter* save_writer);
+int createDeltaStream(const char* stream_name, int field_size,
+                      DeltaStream* delta_stream);
+int openDeltaStream(const char* stream_name, DeltaStream* delta_stream);
+void closeDeltaStream(DeltaStream* delta_stream);
+void putDeltaValue(unsigned char* record, unsigned int value, int bytes);
+unsigned int getDeltaValue(const unsigned char* record, int bytes);
+unsigned char* reserveDeltaRecord(DeltaStream* delta_stream, int record_size);
+void commitDeltaRecord(DeltaStream* delta_stream, unsigned char* record,
+                       int record_size, int record_type,
+                       const DeltaGame* delta_game, int player_turn,
+                       int cell_count, int player1_points, int player2_points);
+int publishMoveDelta(DeltaStream* delta_stream, DeltaGame* delta_game,
+                     Word** game_play_field,
+                     const BoardKernels* board_kernels, int row, int column,
+                     int orientation, int word_size, int player1_points,
+                     int player2_points, int player_turn);
+int publishSnapshotDelta(DeltaStream* delta_stream, DeltaGame* delta_game,
+                         Word** game_play_field,
+                         const BoardKernels* board_kernels,
+                         int player1_points, int player2_points,
+                         int player_turn);
+void publishGameEndDelta(DeltaStream* delta_stream,
+                         const DeltaGame* delta_game, int player1_points,
+                         int player2_points);
+void subscribeDeltaStream(DeltaStream* delta_stream,
+                          DeltaSubscriber* delta_subscriber);
+int readDeltaRecord(DeltaStream* delta_stream,
+                    DeltaSubscriber* delta_subscriber,
+                    const unsigned char** record, int* record_size);
+int deltaRecordOverwritten(DeltaStream* delta_stream,
+                           const DeltaSubscriber* delta_subscriber);
+void printDeltaRecord(const unsigned char* record, int record_type);
+int watchDeltaStream(const char* stream_name);
+char fieldLetter(Word** game_play_field, const BoardKernels* board_kernels,
+                 int row, int column);
+int parseFieldCoordinate(const char* coordinate);
+void formatFieldCoordinate(int coordinate, char* coordinate_text);
+int parseLargeInsertCommand(const char* game_input, Input* player_input,
+                            int* row, int* column);
+Word** createDenseField(int field_size);
+void freeDenseField(Word** game_play_field, int field_size);
+Word* denseFieldCell(Word** game_play_field, int field_size, int row,
+                     int column, int allocate);
+void loadDenseSegment(Word** game_play_field, int field_size, int row,
+                      int column, int orientation, int length, char* segment);
+Word** createChunkedField(int field_size);
+void freeChunkedField(Word** game_play_field, int field_size);
+Word* chunkedFieldCell(Word** game_play_field, int field_size, int row,
+                       int column, int allocate);
+int checkEmptyChunkedField(Word** game_play_field, int field_size);
+void loadChunkedSegment(Word** game_play_field, int field_size, int row,
+                        int column, int orientation, int length,
+                        char* segment);
+void printChunkedField(Word** game_play_field, int field_size);
+int initializeGameState(GameState* game_state, char** file_elements_array,
+                        char* char_points_string, int player1_points,
+                        int player2_points, int field_size, int player_turn,
+                        char* config_name,
+                        const Dictionary* shared_dictionary);
+int freeGameState(GameState* game_state);
+void publishGameState(GameState* game_state, DeltaStream* delta_stream,
+                      unsigned int game);
+int gameStateInsertWord(GameState* game_state, int row, int column,
+                        int orientation, const char* word, int word_size,
+                        int* points_won);
+int gameStateSave(GameState* game_state);
+int gameStateWinner(const GameState* game_state);
+int gamePlayBinarySession(GameState* game_state, FILE* input, FILE* output);
+int binaryStatus(int command, int result);
+void writeBinaryResponse(const GameState* game_state, FILE* output,
+                         int command, int result,
+                         const unsigned char* payload, int payload_size,
+                         int trailing_size);
+void writeBinaryBoard(const GameState* game_state, FILE* output);
+int loadGameState(char* config_name, GameState* game_state,
+                  const Dictionary* shared_dictionary);
+int runToolCommand(int argc, char** argv);
+int playGame(char* config_name, char* stream_name);
+int packedPositionMaxSize(int field_size);
+int encodePackedPosition(Word** game_play_field,
+                         const BoardKernels* board_kernels,
+                         int player1_points, int player2_points,
+                         int player_turn, unsigned char* packed,
+                         int* packed_size);
+int decodePackedPosition(const unsigned char* packed, int packed_size,
+                         Word** game_play_field,
+                         const BoardKernels* board_kernels,
+                         const LetterTable* letter_table,
+                         int* player1_points, int* player2_points,
+                         int* player_turn);
+unsigned long long hashPackedPosition(const unsigned char* packed,
+                                      int packed_size);
+double benchmarkSeconds(void);
+int runPackingBenchmark(char* config_name, int position_count);
+int loadWordList(const char* word_list_name, WordList* word_list);
+void freeWordList(WordList* word_list);
+int searchBestMove(Word** game_play_field, const BoardKernels* board_kernels,
+                   const LetterTable* letter_table, const WordList* word_list,
+                   FieldMove* best_move);
+int openOpeningBook(const char* book_name, OpeningBook* opening_book);
+void closeOpeningBook(OpeningBook* opening_book);
+unsigned int findBookSlot(const unsigned char* book_slots,
+                          unsigned int slot_count, unsigned long long hash);
+int lookupOpeningBook(const OpeningBook* opening_book,
+                      unsigned long long hash, FieldMove* book_move);
+void putBookEntry(unsigned char* book_entry, unsigned long long hash,
+                  const FieldMove* book_move);
+void getBookEntry(const unsigned char* book_entry, FieldMove* book_move);
+int fieldPositionHash(Word** game_play_field,
+                      const BoardKernels* board_kernels, int player1_points,
+                      int player2_points, int player_turn,
+                      unsigned long long* hash);
+int gameStatePositionHash(GameState* game_state, unsigned long long* hash);
+int fieldBookMove(const OpeningBook* opening_book, Word** game_play_field,
+                  const BoardKernels* board_kernels,
+                  const LetterTable* letter_table, int player1_points,
+                  int player2_points, int player_turn, FieldMove* book_move);
+int gameStateBookMove(GameState* game_state, FieldMove* book_move);
+void printBookMove(GameState* game_state);
+int buildOpeningBook(char* book_name, char* word_list_name,
+                     char** config_names, int config_count);
+int writeMappedFile(const char* file_name, const unsigned char* content,
+                    size_t content_size);
+void printFieldMove(const FieldMove* field_move);
+int compareWordPointers(const void* first_word, const void* second_word);
+int buildDictionary(const WordList* word_list, Dictionary* dictionary);
+void fillDictionaryNode(Dictionary* dictionary, const char** sorted_words,
+                        int first_word, int word_end, int depth,
+                        int node_index);
+int loadDictionary(const char* word_list_name, Dictionary* dictionary);
+void freeDictionary(Dictionary* dictionary);
+int compilePattern(const char* pattern, PatternSearch* pattern_search);
+unsigned int patternClosure(const PatternSearch* pattern_search,
+                            unsigned int pattern_states);
+unsigned int patternStep(const PatternSearch* pattern_search,
+                         unsigned int pattern_states, int letter_index);
+int walkPatternSearch(PatternSearch* pattern_search, int node_index,
+                      unsigned int pattern_states, int word_size,
+                      int overlapped);
+int buildAnchorIndex(Dictionary* dictionary);
+int walkAnchoredSearch(PatternSearch* pattern_search, int anchor_distance,
+                       int anchor_letter, unsigned int start_states);
+int addPatternMove(PatternSearch* pattern_search, int word_size);
+int initializePatternSearch(PatternSearch* pattern_search,
+                            Word** game_play_field,
+                            const BoardKernels* board_kernels,
+                            const LetterTable* letter_table,
+                            const Dictionary* dictionary, const char* pattern,
+                            const char* rack);
+int searchPatternLine(PatternSearch* pattern_search, Word** game_play_field,
+                      const BoardKernels* board_kernels, int orientation,
+                      int line_index, int first_start);
+int compareFieldMoves(const void* first_move, const void* second_move);
+int findPatternMoves(Word** game_play_field, const BoardKernels* board_kernels,
+                     const LetterTable* letter_table,
+                     const Dictionary* dictionary, const char* pattern,
+                     FieldMove** moves, int* move_count);
+void printFindMoves(GameState* game_state, const char* pattern);
+FieldMove* appendFieldMove(FieldMove** moves, int* move_count,
+                           int* move_capacity);
+int dictionaryWord(const Dictionary* dictionary, int node_index, char* word);
+unsigned long long anagramLetterKey(int letter);
+int compareAnagramEntries(const void* first_entry, const void* second_entry);
+int buildAnagramIndex(Dictionary* dictionary);
+int findAnagramClass(const Dictionary* dictionary, unsigned long long key,
+                     const int* letter_counts);
+int collectAnagramClasses(RackSearch* rack_search, int letter_index,
+                          unsigned long long key, int letter_total);
+int addRackMove(RackSearch* rack_search, int row, int column, int orientation,
+                const char* word, int word_size, const char* field_segment);
+int addRackPlacements(RackSearch* rack_search, const char* word,
+                      int word_size);
+int loadLetterCells(RackSearch* rack_search);
+int findRackMoves(Word** game_play_field, const BoardKernels* board_kernels,
+                  const LetterTable* letter_table,
+                  const Dictionary* dictionary, const char* rack,
+                  FieldMove** moves, int* move_count, int* word_count);
+void printRackMoves(GameState* game_state);
+int gameStateSetRack(GameState* game_state, const char* letters);
+int rackLettersCheck(GameState* game_state, int row, int column,
+                     int orientation, const char* word, int word_size,
+                     char* rack_left);
+int allocateHintLines(HintLines* hint_lines, int line_count);
+void clearHintLines(HintLines* hint_lines, int line_count);
+void clearHintCache(HintCache* hint_cache);
+void freeHintCache(HintCache* hint_cache);
+void touchHintCache(HintCache* hint_cache, int field_size, int row,
+                    int column, int orientation, int word_size);
+int rackHoldsLetters(const char* rack, const char* letters);
+int selectHintSlot(HintCache* hint_cache, const char* rack);
+int searchHintLine(PatternSearch* pattern_search, HintLines* hint_lines,
+                   int line, GameState* game_state);
+int rackHintMoves(GameState* game_state, const FieldMove* line_moves,
+                  int line_count, int move_limit, FieldMove* rack_moves);
+int gameStateHint(GameState* game_state, int move_limit, double deadline,
+                  FieldMove* moves, int* move_count, int* lines_left);
+void printHint(GameState* game_state, const char* move_limit_text);
+int parseTournamentPlayers(const char* player_specs,
+                           TournamentPlayer** players, int* player_count);
+int loadTournamentBoard(char* config_name, TournamentBoard* tournament_board);
+int tournamentMove(const TournamentPlayer* player, Word** game_play_field,
+                   const BoardKernels* board_kernels,
+                   const LetterTable* letter_table,
+                   const Dictionary* dictionary,
+                   const OpeningBook* opening_book, int player1_points,
+                   int player2_points, int player_turn,
+                   unsigned long long* random_state, FieldMove* field_move);
+int playTournamentGame(Tournament* tournament, int game_index,
+                       ArchiveGame* archive_game);
+int writeTournamentGame(Tournament* tournament, int game_index,
+                        const ArchiveGame* archive_game);
+void* tournamentThread(void* tournament_argument);
+int computeTournamentRatings(const Tournament* tournament, double* ratings,
+                             double* intervals);
+int printTournamentStandings(const Tournament* tournament);
+int runTournament(char* result_name, char* player_specs, char** config_names,
+                  int config_count);
+void switchOutput(FILE* output);
+int beginSessionOutput(ServedSession* served_session);
+int sendSessionOutput(ServedSession* served_session);
+void closeServedSession(ServedSession* served_session);
+ServedSession* openServedSession(int client_socket, char* config_name,
+                                 const Dictionary* dictionary,
+                                 FILE* console_output);
+int serveSession(ServedSession* served_session, unsigned int session_events,
+                 int event_queue, FILE* console_output);
+int runSessionServer(char* port_text, char* config_name, int session_limit);
+size_t dictionaryImageLayout(const Dictionary* dictionary,
+                             size_t* section_offsets);
+char* dictionaryImageName(const char* word_list_name);
+int openDictionaryImage(const char* word_list_name, Dictionary* dictionary);
+int checkDictionaryImage(const Dictionary* dictionary);
+int buildDictionaryImage(char* word_list_name);
+int reserveArchiveColumn(ArchiveColumn* archive_column, size_t extra_size);
+int putArchiveVarint(ArchiveColumn* archive_column, unsigned int value);
+int putArchiveBits(ArchiveColumn* archive_column, unsigned int value,
+                   int bits);
+int getArchiveVarint(ArchiveCursor* archive_cursor, unsigned int* value);
+int getArchiveBits(ArchiveCursor* archive_cursor, int bits,
+                   unsigned int* value);
+void openArchiveCursor(const ArchiveBlock* archive_block, int column_index,
+                       ArchiveCursor* archive_cursor);
+int addArchiveMove(ArchiveGame* archive_game, const FieldMove* field_move,
+                   int player);
+int openArchiveWriter(const char* archive_name, ArchiveWriter* archive_writer);
+int appendArchiveGame(ArchiveWriter* archive_writer,
+                      const ArchiveGame* archive_game);
+int flushArchiveBlock(ArchiveWriter* archive_writer);
+int closeArchiveWriter(ArchiveWriter* archive_writer);
+int openArchiveReader(const char* archive_name, ArchiveReader* archive_reader);
+int nextArchiveBlock(ArchiveReader* archive_reader,
+                     ArchiveBlock* archive_block);
+void closeArchiveReader(ArchiveReader* archive_reader);
+int printArchiveColumn(const ArchiveBlock* archive_block, int column_index);
+int readArchive(char* archive_name, char* column_name);
+int addPositionStats(CorpusStats* corpus_stats, Word** game_play_field,
+                     const BoardKernels* board_kernels,
+                     const LetterTable* letter_table);
+int analyzeSavedPosition(CorpusStats* corpus_stats, char* config_name);
+int analyzeArchiveBlock(CorpusStats* corpus_stats,
+                        const ArchiveBlock* archive_block);
+void* corpusThread(void* thread_argument);
+void mergeCorpusStats(CorpusStats* total_stats, CorpusStats* thread_stats);
+void printCorpusStats(const CorpusStats* corpus_stats);
+int analyzeCorpus(char** file_names, int file_count);
+int fieldMakeMove(Word** game_play_field, const BoardKernels* board_kernels,
+                  const FieldMove* field_move,
+                  const LetterTable* letter_table, int* points_won,
+                  MoveUndo* move_undo);
+void fieldUnmakeMove(Word** game_play_field, const BoardKernels* board_kernels,
+                     const MoveUndo* move_undo);
+int simulateMove(const MonteCarlo* monte_carlo,
+                 MonteCarloThread* monte_carlo_thread, int candidate_index,
+                 unsigned long long* random_state, int* margin);
+void* monteCarloThread(void* thread_argument);
+int compareMonteCarloMoves(const void* first_move, const void* second_move);
+int evaluateMoves(char* config_name, int candidate_count, int simulations);
 
 //------------------------------------------------------------------------------
 ///
@@ -74,51 +1098,62 @@ int gamePlayInsertCommand(Word** game_play_field, Input* player_input,
 //
 int main(int argc, char** argv)
 {
+  if((argc >= ALLOWED_ARGUMENTS) && (strncmp(argv[1], "--", 2) == 0))
+    return runToolCommand(argc, argv);
   if(argc != ALLOWED_ARGUMENTS)
   {
     printf("Usage: ./a3 configfile\n");
     return WRONG_ARGUMENTS_NR;
   }
   int config_id = argc - 1;
-  char* config_name = argv[config_id];
+  return playGame(argv[config_id], NULL);
+}
 
-  FILE* config_text = fopen(config_name, "r");
-  if(config_text == NULL)
-  {
-    printf("Error: Cannot open file: %s\n", config_name);
-    return CANNOT_OPEN_CONFIG_FILE;
-  }
+//------------------------------------------------------------------------------
+///
+/// In the function playGame, we play the game of a config file on the
+/// console until it ends. With a stream name every move of the game is
+/// published to a new delta stream of that name.
+///
+/// @param config_name name of config file.
+/// @param stream_name name of the delta stream, NULL for none.
+///
+/// @return SUCCESS meaning the game ended without a problem.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return CANNOT_OPEN_CONFIG_FILE if a file cannot be opened.
+/// @return INVALID_CONFIG_FILE if the file doesn't start with "Scrabble".
+//
+int playGame(char* config_name, char* stream_name)
+{
+  GameState game_state;
+  int return_value = loadGameState(config_name, &game_state, NULL);
+  if(return_value != SUCCESS)
+    return return_value;
 
-  char* char_points_string = NULL;
-  int player1_points = 0;
-  int player2_points = 0;
-  int field_size = 0;
-  int player_turn = 0;
-  int return_value = 0;
-  char** file_elements_array = getConfigContent(config_text, &return_value,
-                                                &char_points_string,
-                                                &player1_points,
-                                                &player2_points,
-                                                &field_size,
-                                                &player_turn);
-  if(file_elements_array == NULL)
+  DeltaStream delta_stream;
+  memset(&delta_stream, 0, sizeof(DeltaStream));
+  if(stream_name != NULL)
   {
-    if(return_value == INVALID_CONFIG_FILE)
-    {
-      printf("Error: Invalid file: %s\n", config_name);
-      return INVALID_CONFIG_FILE;
-    }
-    else if(return_value == OUT_MEMORY_ERROR)
+    return_value = createDeltaStream(stream_name,
+                                     game_state.board_kernels_.field_size_,
+                                     &delta_stream);
+    if(return_value != SUCCESS)
     {
-      printf("Error: Out of memory\n");
-      return OUT_MEMORY_ERROR;
+      if(return_value == CANNOT_OPEN_CONFIG_FILE)
+        printf("Error: Cannot open file: %s\n", stream_name);
+      else
+        printf("Error: Out of memory\n");
+      freeGameState(&game_state);
+      return return_value;
     }
+    publishGameState(&game_state, &delta_stream, 0);
   }
 
   int memory_error = 0;
-  gamePlayStart(file_elements_array, char_points_string, player1_points,
-                player2_points, field_size, player_turn, &memory_error,
-                config_name);
+  gamePlayStart(&game_state, &memory_error);
+  if(freeGameState(&game_state) == CANNOT_OPEN_CONFIG_FILE)
+    printf("Error: Could not save to file!\n");
+  closeDeltaStream(&delta_stream);
   if(memory_error == OUT_MEMORY_ERROR)
   {
     printf("Error: Out of memory\n");
@@ -289,8 +1324,8 @@ char* getLetterPoints(FILE* config_text)
 char** configToArray(FILE* config_text, int* return_value, int* field_size,
                      int* player_turn)
 {
-  int min_field_size = 4;
-  int max_field_size = 26;
+  int min_field_size = MIN_FIELD_SIZE;
+  int max_field_size = MAX_SPARSE_FIELD_SIZE;
   int char_to_int = 48;
   int zero = 48;
   int nine = 57;
@@ -394,159 +1429,312 @@ char** configToArray(FILE* config_text, int* return_value, int* field_size,
 
 //------------------------------------------------------------------------------
 ///
-/// In the function gamePlayStart, we implement all the game play commands
-/// and logic.
+/// In the function gamePlayStart, we play a game on the console. The game
+/// session does the work, here we only read its lines.
 ///
-/// @param file_elements_array which holds the file in a string format
-/// @param config_name name of config file.
+/// @param game_state the game loaded from the config file.
 /// @param memory_error used to return a certain exit code in case of problems.
-/// @param char_points_string used to get the amount of points per each input.
-/// @param player1_points holds the value of the points for player 1.
-/// @param player2_points holds the value of the points for player 2.
-/// @param field_size holds the size of the field.
-/// @param player_turn shows whos turn it is.
 ///
 /// @return
 //
-void gamePlayStart(char** file_elements_array, char* char_points_string,
-                   int player1_points, int player2_points, int field_size,
-                   int player_turn, int* memory_error, char* config_name)
+void gamePlayStart(GameState* game_state, int* memory_error)
 {
-  Word** game_play_field = initializeGameField(file_elements_array,
-                                               char_points_string, field_size);
-  if(game_play_field == NULL)
+  GameSession game_session;
+  initializeGameSession(&game_session, game_state, stdin, stdout);
+  gameSessionPrompt(&game_session);
+  while(game_session.running_)
   {
+    char* game_input = gamePlayInput();
+    if(game_input == NULL)
+    {
+      game_session.memory_error_ = OUT_MEMORY_ERROR;
+      break;
+    }
+    gameSessionCommand(&game_session, game_input);
+    free(game_input);
+    if(game_session.running_)
+      gameSessionPrompt(&game_session);
+  }
+  free(game_session.line_);
+  if(game_session.memory_error_ == OUT_MEMORY_ERROR)
     *memory_error = OUT_MEMORY_ERROR;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function initializeGameSession, we prepare a session for a loaded
+/// game. Nothing is printed yet.
+///
+/// @param game_session the session to prepare.
+/// @param game_state the game, which stays owned by the caller.
+/// @param binary_input stream of the "binary" command, NULL to refuse it.
+/// @param binary_output stream of the binary responses.
+///
+/// @return
+//
+void initializeGameSession(GameSession* game_session, GameState* game_state,
+                           FILE* binary_input, FILE* binary_output)
+{
+  memset(game_session, 0, sizeof(GameSession));
+  game_session->game_state_ = game_state;
+  game_session->binary_input_ = binary_input;
+  game_session->binary_output_ = binary_output;
+  game_session->printing_check_ = 1;
+  game_session->running_ = 1;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameSessionPrompt, we print what a player sees before a
+/// command: the field after a move, a failed background save and the prompt.
+///
+/// @param game_session the running session.
+///
+/// @return
+//
+void gameSessionPrompt(GameSession* game_session)
+{
+  GameState* game_state = game_session->game_state_;
+  if(game_session->printing_check_)
+    gameProgressPrint(game_state->game_play_field_,
+                      game_state->char_points_string_,
+                      &game_state->board_kernels_,
+                      game_state->player1_points_,
+                      game_state->player2_points_);
+  game_session->printing_check_ = 0;
+  // a background save which failed is reported before the next command
+  if(takeSaveWriterError(&game_state->save_writer_) != SUCCESS)
+    printf("Error: Could not save to file!\n");
+  printf("Player %d > ", game_state->player_turn_);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameSessionCommand, we run one command line of a
+/// session. An empty line, "quit", a win or a memory error end the session.
+///
+/// @param game_session the running session.
+/// @param game_input the line in lowercase, changed by the parsing.
+///
+/// @return
+//
+void gameSessionCommand(GameSession* game_session, char* game_input)
+{
+  GameState* game_state = game_session->game_state_;
+  int field_size = game_state->board_kernels_.field_size_;
+  char eos = '\0';
+  if(game_input[0] == eos)
+  {
+    game_session->running_ = 0;
+    return;
+  }
+  Input* player_input = (Input*)malloc(sizeof(Input));
+  if(player_input == NULL)
+  {
+    game_session->memory_error_ = OUT_MEMORY_ERROR;
+    game_session->running_ = 0;
     return;
   }
-  int winning_points = (field_size * field_size)/2;
 
-  char eos = '\0';
-  int printing_check = 1;
-  int player_1 = 1;
-  int player_2 = 2;
-  int game_loop = 1;
-  while(game_loop)
+  parseCommand(game_input, player_input);
+
+  // coordinates with more than one letter for fields bigger than 26
+  int field_row = 0;
+  int field_column = 0;
+  int coordinates_parsed = 0;
+  if(field_size > MAX_FIELD_SIZE)
+    coordinates_parsed = parseLargeInsertCommand(game_input, player_input,
+                                                 &field_row, &field_column);
+
+  if((player_input->is_error_) &&
+     (player_input->command_ != UNKNOWN))
   {
-    int change_player_flag = 1;
+    printf("Error: Insert parameters not valid!\n");
+    free(player_input);
+    return;
+  }
 
-    if(printing_check)
-      gameProgressPrint(game_play_field, char_points_string,
-                        field_size, player1_points, player2_points);
-    printing_check = 0;
-    Input* player_input = (Input*)malloc(sizeof(Input));
-    if(player_input == NULL)
-    {
-      *memory_error = OUT_MEMORY_ERROR;
-      break;
-    }
-    printf("Player %d > ", player_turn);
-    char* game_input = gamePlayInput();
-    if(game_input == NULL)
+  if(player_input->command_ == INSERT)
+  {
+    game_session->printing_check_ = 1;
+    int error_return_value = 1;
+    int error_invalid_param = 2;
+    int char_to_coordinate = 97;
+    int points_won = 0;
+    if(!coordinates_parsed)
     {
-      free(player_input);
-      *memory_error = OUT_MEMORY_ERROR;
-      break;
+      field_row = player_input->row_ - char_to_coordinate;
+      field_column = player_input->column_ - char_to_coordinate;
     }
-    if(game_input[0] == eos)
+    int return_value = gameStateInsertWord(game_state, field_row,
+                                           field_column,
+                                           player_input->orientation_,
+                                           player_input->word_,
+                                           (int)strlen(player_input->word_),
+                                           &points_won);
+    if(return_value == OUT_MEMORY_ERROR)
     {
-      free(game_input);
-      free(player_input);
-      break;
+      game_session->memory_error_ = OUT_MEMORY_ERROR;
+      game_session->running_ = 0;
     }
-
-    parseCommand(game_input, player_input);
-
-    if((player_input->is_error_) &&
-       (player_input->command_ != UNKNOWN))
+    if(return_value != SUCCESS)
     {
-      printf("Error: Insert parameters not valid!\n");
-      free(game_input);
-      free(player_input);
-      continue;
+      if(return_value == error_return_value)
+        printf("Error: Impossible move!\n");
+      if(return_value == error_invalid_param)
+        printf("Error: Insert parameters not valid!\n");
+      game_session->printing_check_ = 0;
     }
-
-    if(player_input->command_ == INSERT)
+  }
+  else if((player_input->command_ == SAVE) && (game_session->save_refused_))
+  {
+    printf("Error: Saving is not possible in a served game!\n");
+  }
+  else if(player_input->command_ == SAVE)
+  {
+    // the file is written in the background from a snapshot
+    int return_value = gameStateSave(game_state);
+    if(return_value == OUT_MEMORY_ERROR)
     {
-      printing_check = 1;
-      int error_return_value = 1;
-      int error_invalid_param = 2;
-      int points_won = 0;
-      int return_value = gamePlayInsertCommand(game_play_field, player_input,
-                                               char_points_string, field_size,
-                                               &points_won);
-      if(return_value != SUCCESS)
-      {
-        if(return_value == error_return_value)
-          printf("Error: Impossible move!\n");
-        if(return_value == error_invalid_param)
-          printf("Error: Insert parameters not valid!\n");
-        printing_check = 0;
-        change_player_flag = 0;
-      }
-      else
-      {
-        if(player_turn == player_1)
-          player1_points += points_won;
-        else
-          player2_points += points_won;
-      }
+      game_session->memory_error_ = OUT_MEMORY_ERROR;
+      game_session->running_ = 0;
     }
-    else if(player_input->command_ == SAVE)
+    else if(return_value == CANNOT_OPEN_CONFIG_FILE)
     {
-      int return_value = gamePlaySaveCommand(config_name, game_play_field,
-                                             char_points_string, field_size,
-                                             player1_points, player2_points,
-                                             player_turn);
-      if(return_value == CANNOT_OPEN_CONFIG_FILE)
-        printf("Error: Could not save to file!\n");
-      change_player_flag = 0;
+      printf("Error: Could not save to file!\n");
     }
-    else if(player_input->command_ == QUIT)
+  }
+  else if(player_input->command_ == QUIT)
+  {
+    game_session->running_ = 0;
+  }
+  else if(player_input->command_ == HELP)
+  {
+    printHelpCommand();
+  }
+  else
+  {
+    char* command_wrong = strtok(game_input, TOKEN_SEPARATORS);
+    if((command_wrong != NULL) && (strcmp(command_wrong, "binary") == 0) &&
+       (game_session->binary_input_ != NULL))
     {
-      game_loop = 0;
+      // bots keep sending binary frames until the game ends
+      if(gamePlayBinarySession(game_state, game_session->binary_input_,
+                               game_session->binary_output_) ==
+         OUT_MEMORY_ERROR)
+        game_session->memory_error_ = OUT_MEMORY_ERROR;
+      game_session->running_ = 0;
     }
-    else if(player_input->command_ == HELP)
+    else if((command_wrong != NULL) && (strcmp(command_wrong, "book") == 0))
+      printBookMove(game_state);
+    else if((command_wrong != NULL) && (strcmp(command_wrong, "find") == 0))
+      printFindMoves(game_state, strtok(NULL, TOKEN_SEPARATORS));
+    else if((command_wrong != NULL) && (strcmp(command_wrong, "rack") == 0))
     {
-      printHelpCommand();
-      change_player_flag = 0;
+      if(gameStateSetRack(game_state, strtok(NULL, TOKEN_SEPARATORS)) !=
+         SUCCESS)
+        printf("Error: Insert parameters not valid!\n");
     }
+    else if((command_wrong != NULL) && (strcmp(command_wrong, "words") == 0))
+      printRackMoves(game_state);
+    else if((command_wrong != NULL) && (strcmp(command_wrong, "hint") == 0))
+      printHint(game_state, strtok(NULL, TOKEN_SEPARATORS));
+    else if((command_wrong != NULL) &&
+            (strcmp(command_wrong, "status") == 0))
+      printSaveStatus(game_state);
     else
-    {
-      char* command_wrong = strtok(game_input, TOKEN_SEPARATORS);
       printf("Error: Unknown command: %s\n", command_wrong);
-      change_player_flag = 0;
-    }
-    if(change_player_flag)
-    {
-      if(player_turn != player_1)
-        player_turn = player_1;
-      else
-        player_turn = player_2;
-    }
+  }
 
-    free(game_input);
-    free(player_input->word_);
-    free(player_input);
+  free(player_input->word_);
+  free(player_input);
+
+  int winner = gameStateWinner(game_state);
+  if(game_session->running_ && winner)
+  {
+    int winner_points = game_state->player1_points_;
+    if(winner != 1)
+      winner_points = game_state->player2_points_;
+    printf("Player %d has won the game with %d points!\n",
+           winner, winner_points);
+    game_session->running_ = 0;
+  }
+}
 
-    if(player1_points >= winning_points)
+//------------------------------------------------------------------------------
+///
+/// In the function feedGameSession, we hand input to a session as it
+/// arrives. Every complete line runs as a command, a partial line waits for
+/// the rest, so a session never blocks for input.
+///
+/// @param game_session the running session.
+/// @param input the bytes read, not terminated.
+/// @param input_size the number of bytes.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int feedGameSession(GameSession* game_session, const char* input,
+                    int input_size)
+{
+  char eos = '\0';
+  char new_line = '\n';
+  int malloc_init = 1;
+  int input_iterator = 0;
+  for(input_iterator = 0;
+      (input_iterator < input_size) && game_session->running_;
+      input_iterator++)
+  {
+    if(game_session->line_size_ + malloc_init >= game_session->line_capacity_)
     {
-      printf("Player %d has won the game with %d points!\n",
-             player_1, player1_points);
-      break;
+      int line_capacity = 2 * game_session->line_capacity_ + malloc_init;
+      char* temp_pointer = (char*)realloc(game_session->line_,
+                                          line_capacity * sizeof(char));
+      if(temp_pointer == NULL)
+      {
+        game_session->memory_error_ = OUT_MEMORY_ERROR;
+        game_session->running_ = 0;
+        return OUT_MEMORY_ERROR;
+      }
+      game_session->line_ = temp_pointer;
+      game_session->line_capacity_ = line_capacity;
     }
-    if(player2_points >= winning_points)
+    if(input[input_iterator] != new_line)
     {
-      printf("Player %d has won the game with %d points!\n",
-             player_2, player2_points);
-      break;
+      game_session->line_[game_session->line_size_++] =
+          (char)tolower(input[input_iterator]);
+      continue;
     }
+    game_session->line_[game_session->line_size_] = eos;
+    game_session->line_size_ = 0;
+    gameSessionCommand(game_session, game_session->line_);
+    if(game_session->running_)
+      gameSessionPrompt(game_session);
   }
-  free(char_points_string);
-  int outer_iterator = 0;
-  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
-    free(game_play_field[outer_iterator]);
-  free(game_play_field);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function endGameSessionInput, we end a session whose input is
+/// closed. Like on the console, an unfinished last line still runs.
+///
+/// @param game_session the session.
+///
+/// @return
+//
+void endGameSessionInput(GameSession* game_session)
+{
+  char eos = '\0';
+  if(game_session->running_ && (game_session->line_size_ > 0))
+  {
+    game_session->line_[game_session->line_size_] = eos;
+    game_session->line_size_ = 0;
+    gameSessionCommand(game_session, game_session->line_);
+    if(game_session->running_)
+      gameSessionPrompt(game_session);
+  }
+  game_session->running_ = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -556,83 +1744,58 @@ void gamePlayStart(char** file_elements_array, char* char_points_string,
 ///
 /// @param file_elements_array which holds the file in a string format
 /// @param char_points_string used to get the amount of points per each input.
-/// @param field_size holds the size of the field.
+/// @param board_kernels board storage for the size of the field.
 ///
 /// @return NULL in case of problems.
 /// @return game_play_field gives the state of the playing field.
 //
 Word** initializeGameField(char** file_elements_array, char* char_points_string,
-                           int field_size)
+                           const BoardKernels* board_kernels)
 {
   int char_to_decimal = 48;
   char space = ' ';
   char eos = '\0';
+  int allocate_cell = 1;
+  int field_size = board_kernels->field_size_;
 
-  Word** game_play_field = (Word**)malloc(field_size * sizeof(Word*));
-  if(game_play_field == NULL)
-  {
-    int outer_iterator = 0;
-    for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
-      free(file_elements_array[outer_iterator]);
-    free(file_elements_array);
-    free(char_points_string);
-    return NULL;
-  }
-
+  Word** game_play_field = board_kernels->create_field_(field_size);
   int outer_iterator = 0;
-  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
+  for(outer_iterator = 0;
+      (game_play_field != NULL) && (outer_iterator < field_size);
+      outer_iterator++)
   {
-    Word* game_play_row = (Word*)malloc(field_size * sizeof(Word));
-    if(game_play_row == NULL)
+    int inner_iterator = 0;
+    for(inner_iterator = 0;
+        (file_elements_array[outer_iterator][inner_iterator] != eos) &&
+        (inner_iterator < field_size);
+        inner_iterator++)
     {
-      int free_iterator = 0;
-      for(free_iterator = 0; free_iterator < field_size; free_iterator++)
-        free(file_elements_array[free_iterator]);
-      free(file_elements_array);
-      free(char_points_string);
+      char actual_character =
+          file_elements_array[outer_iterator][inner_iterator];
+      if(actual_character == space)
+        continue;
 
-      for(free_iterator = 0; free_iterator < outer_iterator; free_iterator++)
-        free(game_play_field[free_iterator]);
-      free(game_play_field);
-      return NULL;
-    }
+      Word* field_cell = board_kernels->cell_(game_play_field, field_size,
+                                              outer_iterator, inner_iterator,
+                                              allocate_cell);
+      if(field_cell == NULL)
+      {
+        board_kernels->free_field_(game_play_field, field_size);
+        game_play_field = NULL;
+        break;
+      }
+      field_cell->letter_ = actual_character;
 
-    int inner_iterator = 0;
-    for(inner_iterator = 0; inner_iterator < field_size; inner_iterator++)
-    {
-      game_play_row[inner_iterator].letter_ = space;
-      game_play_row[inner_iterator].letter_points_ = 0;
-    }
-    game_play_field[outer_iterator] = game_play_row;
-  }
-
-  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
-  {
-    int inner_iterator = 0;
-    for(inner_iterator = 0;
-        file_elements_array[outer_iterator][inner_iterator] != eos;
-        inner_iterator++)
-    {
-      char actual_character =
-          file_elements_array[outer_iterator][inner_iterator];
-
-      if(actual_character != space)
+      int point_iterate = 0;
+      for(point_iterate = 0; char_points_string[point_iterate] != eos;
+          point_iterate++)
       {
-        game_play_field[outer_iterator][inner_iterator].letter_ =
-            actual_character;
-
-        int point_iterate = 0;
-        for(point_iterate = 0; char_points_string[point_iterate] != eos;
-            point_iterate++)
+        if(char_points_string[point_iterate] == tolower(actual_character))
         {
-          if(char_points_string[point_iterate] == tolower(actual_character))
-          {
-            int points_char =
-                (int)char_points_string[point_iterate + 1] - char_to_decimal;
-            game_play_field[outer_iterator][inner_iterator].letter_points_ =
-                points_char;
-            break;
-          }
+          int points_char =
+              (int)char_points_string[point_iterate + 1] - char_to_decimal;
+          field_cell->letter_points_ = points_char;
+          break;
         }
       }
     }
@@ -641,6 +1804,8 @@ Word** initializeGameField(char** file_elements_array, char* char_points_string,
   for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
     free(file_elements_array[outer_iterator]);
   free(file_elements_array);
+  if(game_play_field == NULL)
+    free(char_points_string);
 
   return game_play_field;
 }
@@ -759,7 +1924,7 @@ void printLetterPlayerPoints(char* char_points_string, int player1_points,
 ///
 /// In the function gameProgressPrint, we print the current game state.
 ///
-/// @param field_size holds the size of the field
+/// @param board_kernels board operations for the size of the field.
 /// @param char_points_string used to get the amount of points per each input.
 /// @param player1_points holds the value of the points for player 1.
 /// @param player2_points holds the value of the points for player 2.
@@ -768,130 +1933,78 @@ void printLetterPlayerPoints(char* char_points_string, int player1_points,
 /// @return
 //
 void gameProgressPrint(Word** game_play_field, char* char_points_string,
-                       int field_size, int player1_points, int player2_points)
+                       const BoardKernels* board_kernels, int player1_points,
+                       int player2_points)
 {
   printLetterPlayerPoints(char_points_string, player1_points, player2_points);
 
-  // print upper part of field
-  int print_iterator = 0;
-  int start_letter_a = 65;
-  for(print_iterator = 0; print_iterator < field_size; print_iterator++)
-  {
-    if(print_iterator == 0)
-      printf(" |");
-    printf("%c", start_letter_a + print_iterator);
-  }
-  printf("\n");
-  int new_field_size = field_size + 2;
-  for(print_iterator = 0; print_iterator < new_field_size; print_iterator++)
-    printf("-");
-  printf("\n");
-
-  // print field content
-  int outer_iterator = 0;
-  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
-  {
-    printf("%c|", start_letter_a + outer_iterator);
-    int inner_iterator = 0;
-    for(inner_iterator = 0; inner_iterator < field_size; inner_iterator++)
-    {
-      printf("%c",
-             game_play_field[outer_iterator][inner_iterator].letter_);
-    }
-    printf("\n");
-  }
+  board_kernels->print_field_(game_play_field, board_kernels->field_size_);
   printf("\n");
 }
 
 //------------------------------------------------------------------------------
 ///
-/// In the function gamePlaySaveCommand, saves the game field, player turn,
-/// players points and char-points string to the old config file.
-/// It overwrites it with the new content.
+/// In the function checkWordInput, we check if the word input can be placed
+/// on the game field or not. Every letter of the word is counted as often as
+/// it is found in the char points string.
 ///
-/// @param field_size holds the size of the field
-/// @param char_points_string used to get the amount of points per each input.
-/// @param player1_points hold the value of the points for player 1.
-/// @param player2_points hold the value of the points for player 2.
-/// @param config_name name of config file.
-/// @param game_play_field holds the actual state of the game field.
-/// @param player_turn shows whos turn it is.
+/// @param word the given word, only lowercase letters.
+/// @param word_size the number of letters in the word.
+/// @param letter_table the letters of the char points string.
 ///
-/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be opened.
 /// @return SUCCESS if no problems were detected.
 //
-int gamePlaySaveCommand(char* config_name, Word** game_play_field,
-                        char* char_points_string, int field_size,
-                        int player1_points, int player2_points,
-                        int player_turn)
+int checkWordInput(const char* word, int word_size,
+                   const LetterTable* letter_table)
 {
-  char magic_nr[] = "Scrabble";
-
-  FILE* config_text = fopen(config_name, "w");
-  if(config_text == NULL)
-    return CANNOT_OPEN_CONFIG_FILE;
-
-  fputs(magic_nr, config_text);
-  fputs("\n", config_text);
-
-  int outer_iterator = 0;
-  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
-  {
-    int inner_iterator = 0;
-    for(inner_iterator = 0; inner_iterator < field_size; inner_iterator++)
-    {
-      fputc(game_play_field[outer_iterator][inner_iterator].letter_,
-            config_text);
-    }
-    fputs("\n", config_text);
-  }
-  fprintf(config_text,"%d\n", player_turn);
-  fprintf(config_text,"%d\n", player1_points);
-  fprintf(config_text,"%d\n", player2_points);
-  fputs(char_points_string, config_text);
-
-  fclose(config_text);
+  int error_return_value = 1;
+  char small_a = 'a';
+  int letter_exists_count = 0;
+  int word_iterator = 0;
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+    letter_exists_count += letter_table->counts_[word[word_iterator] - small_a];
+  if(letter_exists_count != word_size)
+    return error_return_value;
   return SUCCESS;
 }
 
 //------------------------------------------------------------------------------
 ///
-/// In the function checkWordInput, we check if the word input can be placed
-/// on the game field or not.
+/// In the function buildLetterTable, we count the letters of the char
+/// points string and store the points following each of them. The last
+/// occurrence of a letter gives its points.
 ///
 /// @param char_points_string used to get the amount of points per each input.
-/// @param player_input the given input.
+/// @param letter_table receives the counts and points per letter.
 ///
-/// @return SUCCESS if no problems were detected.
+/// @return
 //
-int checkWordInput(Input* player_input, const char* char_points_string)
+void buildLetterTable(const char* char_points_string,
+                      LetterTable* letter_table)
 {
   char eos = '\0';
-  int error_return_value = 1;
-  int letter_exists_count = 0;
-  int word_iterator = 0;
-  for(word_iterator = 0; player_input->word_[word_iterator] != eos;
-      word_iterator++)
+  char small_a = 'a';
+  char small_z = 'z';
+  int char_to_int = 48;
+
+  memset(letter_table, 0, sizeof(LetterTable));
+  int point_iterator = 0;
+  for(point_iterator = 0; char_points_string[point_iterator] != eos;
+      point_iterator++)
   {
-    int word_point_iterator = 0;
-    for(word_point_iterator = 0;
-        char_points_string[word_point_iterator] != eos; word_point_iterator++)
-    {
-      if(player_input->word_[word_iterator] ==
-         char_points_string[word_point_iterator])
-        letter_exists_count++;
-    }
+    char point_char = char_points_string[point_iterator];
+    if((point_char < small_a) || (point_char > small_z))
+      continue;
+    letter_table->counts_[point_char - small_a]++;
+    letter_table->points_[point_char - small_a] =
+        char_points_string[point_iterator + 1] - char_to_int;
   }
-  int word_input_size = (int)strlen(player_input->word_);
-  if(letter_exists_count != word_input_size)
-    return error_return_value;
-  return SUCCESS;
 }
 
 //------------------------------------------------------------------------------
 ///
 /// In the function checkEmptyField, we check if the game field is empty
-/// or not.
+/// or not. Inlined into the fixed size board kernels.
 ///
 /// @param game_play_field holds the current state of the game field.
 /// @param field_size holds the size of the field.
@@ -899,7 +2012,8 @@ int checkWordInput(Input* player_input, const char* char_points_string)
 /// @return SUCCESS if no problems were detected.
 /// @return empty_field if no letters are found.
 //
-int checkEmptyField(Word** game_play_field, int field_size)
+BOARD_KERNEL_INLINE int checkEmptyField(Word** game_play_field,
+                                        int field_size)
 {
   char space = ' ';
   int empty_field = 1;
@@ -919,174 +2033,9509 @@ int checkEmptyField(Word** game_play_field, int field_size)
 
 //------------------------------------------------------------------------------
 ///
-/// In the function wordPlacementCheck, we check if the word input
-/// can be placed on the game field or not. It is done by colling
-/// different help functions and if else checks.
+/// In the function fieldPlacementCheck, we check if a word can be placed
+/// at the given coordinates. It is done by colling different help functions
+/// and if else checks, the cells below the word are compared against it at
+/// once by segmentMatchCheck.
 ///
 /// @param game_play_field holds the current state of the game field.
-/// @param field_size holds the size of the field.
-/// @param player_input the given input.
-/// @param char_points_string used to get the amount of points per each input.
+/// @param board_kernels board operations for the size of the field.
+/// @param row first row of the word, counted from 0.
+/// @param column first column of the word, counted from 0.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param word the lowercased word.
+/// @param word_size the number of letters in the word.
+/// @param letter_table the letters of the char points string.
 ///
 /// @return SUCCESS if no problems were detected.
-/// @return error_return_value
+/// @return error_return_value if the move is impossible.
+/// @return error_invalid_param if the coordinates are not on the field.
 //
-int wordPlacementCheck(Word** game_play_field, Input* player_input,
-                       char* char_points_string, int field_size)
+int fieldPlacementCheck(Word** game_play_field,
+                        const BoardKernels* board_kernels, int row,
+                        int column, int orientation, const char* word,
+                        int word_size, const LetterTable* letter_table)
 {
   char eos = '\0';
-  char space = ' ';
+  int error_return_value = 1;
+  int field_size = board_kernels->field_size_;
+
+  int return_value = placementParameterCheck(field_size, row, column,
+                                             orientation, word, word_size,
+                                             letter_table);
+  if(return_value != SUCCESS)
+    return return_value;
+
+  // if field is empty dont do the extra field check
+  int field_empty = board_kernels->check_empty_(game_play_field, field_size);
+  if(field_empty)
+    return SUCCESS;
+
+  // check word placement on field, the cells below the word are compared
+  // against it at once
+  char field_segment[FIELD_SEGMENT_BUFFER];
+  char word_segment[FIELD_SEGMENT_BUFFER];
+  memcpy(word_segment, word, word_size);
+  memset(word_segment + word_size, eos, SEGMENT_VECTOR_SIZE);
+  board_kernels->load_segment_(game_play_field, field_size, row, column,
+                               orientation, word_size, field_segment);
+
+  int segment_flags = segmentMatchCheck(field_segment, word_segment,
+                                        word_size);
+  if(segment_flags & SEGMENT_CONFLICT)
+    return error_return_value;
+  if(!(segment_flags & SEGMENT_OVERLAP))
+    return error_return_value;
+
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function placementParameterCheck, we check the parts of an insert
+/// which do not depend on the letters on the field.
+///
+/// @param field_size holds the size of the field.
+/// @param row first row of the word, counted from 0.
+/// @param column first column of the word, counted from 0.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param word the lowercased word.
+/// @param word_size the number of letters in the word.
+/// @param letter_table the letters of the char points string.
+///
+/// @return SUCCESS if no problems were detected.
+/// @return error_return_value if the word does not fit or has bad letters.
+/// @return error_invalid_param if the word is empty or the coordinates are
+///                             not on the field.
+//
+int placementParameterCheck(int field_size, int row, int column,
+                            int orientation, const char* word, int word_size,
+                            const LetterTable* letter_table)
+{
   int error_return_value = 1;
   int error_invalid_param = 2;
-  int char_to_coordinate = 97;
   int small_a = 97;
   int small_z = 122;
 
   // check word placement bigger than field
-  int word_start_position = 0;
-  int word_size = (int)strlen(player_input->word_);
-  if(player_input->orientation_)
-    word_start_position = player_input->row_ - char_to_coordinate;
-  else
-    word_start_position = player_input->column_ - char_to_coordinate;
+  int word_start_position = column;
+  if(orientation)
+    word_start_position = row;
 
+  if(word_size < 1)
+    return error_invalid_param;
   int word_position_length = word_start_position + word_size;
   if(word_position_length > field_size)
     return error_return_value;
 
   // check word content
   int word_iterator = 0;
-  for(word_iterator = 0; player_input->word_[word_iterator] != eos;
-      word_iterator++)
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
   {
-    char word_char =  player_input->word_[word_iterator];
+    char word_char = word[word_iterator];
     if((word_char < small_a) || (word_char > small_z))
       return error_return_value;
   }
-  int check_word_input = checkWordInput(player_input, char_points_string);
+  int check_word_input = checkWordInput(word, word_size, letter_table);
   if(check_word_input)
     return error_return_value;
 
   // check coordinates content
-  if((player_input->row_ < small_a) || (player_input->row_ > small_z))
-    return error_invalid_param;
-  if((player_input->column_ < small_a) || (player_input->column_ > small_z))
+  if((row < 0) || (row >= field_size) || (column < 0) ||
+     (column >= field_size))
     return error_invalid_param;
-  if(((player_input->row_ - char_to_coordinate) >= field_size) ||
-     ((player_input->column_ - char_to_coordinate) >= field_size))
-    return error_invalid_param;
-
-  // if field is empty dont do the extra field check
-  int field_empty = checkEmptyField(game_play_field, field_size);
-  if(field_empty)
-    return SUCCESS;
-
-  // check word placement on field
-  int row_coordinate = player_input->row_ - char_to_coordinate;
-  int column_coordinate = player_input->column_ - char_to_coordinate;
 
-  int wrong_placement = 1;
-  for(word_iterator = 0; player_input->word_[word_iterator] != eos;
-      word_iterator++)
-  {
-    char word_char =  player_input->word_[word_iterator];
+  return SUCCESS;
+}
 
-    char field_char =
-        game_play_field[row_coordinate][column_coordinate].letter_;
-    field_char = (char)tolower(field_char);
+//------------------------------------------------------------------------------
+///
+/// In the function fieldInsertWord, we check a word and write it to the
+/// field. All cells are allocated before the first letter is written, so a
+/// failed allocation leaves the field unchanged.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param row first row of the word, counted from 0.
+/// @param column first column of the word, counted from 0.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param word the lowercased word.
+/// @param word_size the number of letters in the word.
+/// @param letter_table the letters of the char points string.
+/// @param points_won increased by the points of the newly placed letters.
+///
+/// @return SUCCESS if no problems were detected.
+/// @return OUT_MEMORY_ERROR if a chunk of the field could not be allocated.
+/// @return return_value of fieldPlacementCheck otherwise.
+//
+int fieldInsertWord(Word** game_play_field, const BoardKernels* board_kernels,
+                    int row, int column, int orientation, const char* word,
+                    int word_size, const LetterTable* letter_table,
+                    int* points_won)
+{
+  char space = ' ';
+  char small_a = 'a';
+  int allocate_cell = 1;
+  int field_size = board_kernels->field_size_;
 
-    if((field_char != word_char) && (field_char != space))
-      return error_return_value;
+  int return_value = fieldPlacementCheck(game_play_field, board_kernels, row,
+                                         column, orientation, word, word_size,
+                                         letter_table);
+  if(return_value != SUCCESS)
+    return return_value;
 
-    if(field_char == word_char)
-      wrong_placement = 0;
+  Word* word_cells[FIELD_SEGMENT_BUFFER];
+  int row_coordinate = row;
+  int column_coordinate = column;
+  int word_iterator = 0;
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+  {
+    word_cells[word_iterator] = board_kernels->cell_(
+        game_play_field, field_size, row_coordinate, column_coordinate,
+        allocate_cell);
+    if(word_cells[word_iterator] == NULL)
+      return OUT_MEMORY_ERROR;
 
-    if(player_input->orientation_)
+    if(orientation)
       row_coordinate++;
     else
       column_coordinate++;
   }
-  if(wrong_placement)
-    return error_return_value;
 
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+  {
+    char word_char = (char)toupper(word[word_iterator]);
+    int letter_points = letter_table->points_[word[word_iterator] - small_a];
+    if(word_cells[word_iterator]->letter_ == space)
+      *points_won += letter_points;
+    word_cells[word_iterator]->letter_ = word_char;
+    word_cells[word_iterator]->letter_points_ = letter_points;
+  }
   return SUCCESS;
 }
 
 //------------------------------------------------------------------------------
 ///
-/// In the function pointLetterInput, we get the points representing a
-/// specific letter. It is done by parsing the char_points_string variable.
+/// In the function fieldLetter, we get the letter of one cell. Cells of
+/// chunks which were never written are free.
 ///
-/// @param word_char
-/// @param char_points_string used to get the amount of points per each input.
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param row the row of the cell.
+/// @param column the column of the cell.
+///
+/// @return the letter of the cell, or a space.
+//
+char fieldLetter(Word** game_play_field, const BoardKernels* board_kernels,
+                 int row, int column)
+{
+  char space = ' ';
+  int allocate_cell = 0;
+  Word* field_cell = board_kernels->cell_(game_play_field,
+                                          board_kernels->field_size_, row,
+                                          column, allocate_cell);
+  if(field_cell == NULL)
+    return space;
+  return field_cell->letter_;
+}
+
+//------------------------------------------------------------------------------
 ///
-/// @return word_points
+/// In the function parseFieldCoordinate, we convert a coordinate of one or
+/// more letters into a number. Like spreadsheet columns "a" is 0, "z" is 25,
+/// "aa" is 26 and so on.
+///
+/// @param coordinate the lowercased coordinate.
+///
+/// @return -1 if the coordinate is not valid.
+/// @return coordinate_value counted from 0.
 //
-int pointLetterInput(char word_char, const char* char_points_string)
+int parseFieldCoordinate(const char* coordinate)
 {
   char eos = '\0';
-  int char_to_int = 48;
-  int word_points = 0;
+  char small_a = 'a';
+  char small_z = 'z';
+  int alphabet_size = 26;
+  int invalid_coordinate = -1;
 
-  int word_point_iterator = 0;
-  for(word_point_iterator = 0; char_points_string[word_point_iterator] != eos;
-      word_point_iterator++)
+  int coordinate_value = 0;
+  int coordinate_iterator = 0;
+  for(coordinate_iterator = 0; coordinate[coordinate_iterator] != eos;
+      coordinate_iterator++)
   {
-    if(word_char== char_points_string[word_point_iterator])
-    {
-      word_points = char_points_string[word_point_iterator + 1] - char_to_int;
-    }
+    char coordinate_char = coordinate[coordinate_iterator];
+    if((coordinate_char < small_a) || (coordinate_char > small_z) ||
+       (coordinate_iterator >= MAX_COORDINATE_LENGTH))
+      return invalid_coordinate;
+    coordinate_value = coordinate_value * alphabet_size +
+                       (coordinate_char - small_a + 1);
+  }
+  if(coordinate_iterator == 0)
+    return invalid_coordinate;
+  return coordinate_value - 1;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function formatFieldCoordinate, we convert a number into its
+/// uppercase letter coordinate, the reverse of parseFieldCoordinate.
+///
+/// @param coordinate counted from 0.
+/// @param coordinate_text receives the coordinate, at least
+///                        MAX_COORDINATE_LENGTH + 1 chars.
+///
+/// @return
+//
+void formatFieldCoordinate(int coordinate, char* coordinate_text)
+{
+  char eos = '\0';
+  char start_letter_a = 'A';
+  int alphabet_size = 26;
+
+  char reversed_text[MAX_COORDINATE_LENGTH + 1];
+  int text_length = 0;
+  int coordinate_value = coordinate + 1;
+  while((coordinate_value > 0) && (text_length < MAX_COORDINATE_LENGTH))
+  {
+    coordinate_value--;
+    reversed_text[text_length] =
+        (char)(start_letter_a + coordinate_value % alphabet_size);
+    coordinate_value /= alphabet_size;
+    text_length++;
+  }
+  int text_iterator = 0;
+  for(text_iterator = 0; text_iterator < text_length; text_iterator++)
+    coordinate_text[text_iterator] =
+        reversed_text[text_length - text_iterator - 1];
+  coordinate_text[text_length] = eos;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function parseLargeInsertCommand, we parse an insert command with
+/// coordinates of more than one letter, which the framework parser does not
+/// accept. On success the input is turned into a valid insert command.
+///
+/// @param game_input the lowercased command line.
+/// @param player_input the input filled by parseCommand.
+/// @param row receives the row, counted from 0.
+/// @param column receives the column, counted from 0.
+///
+/// @return 1 if the command was an insert with valid letter coordinates.
+/// @return 0 otherwise, player_input is left as it is.
+//
+int parseLargeInsertCommand(const char* game_input, Input* player_input,
+                            int* row, int* column)
+{
+  char insert_command[] = "insert";
+  char horizontal = 'h';
+  char vertical = 'v';
+  char eos = '\0';
+
+  size_t input_size = strlen(game_input) + 1;
+  char* input_copy = (char*)malloc(input_size * sizeof(char));
+  if(input_copy == NULL)
+    return 0;
+  memcpy(input_copy, game_input, input_size);
+
+  char* command = strtok(input_copy, TOKEN_SEPARATORS);
+  char* row_text = strtok(NULL, TOKEN_SEPARATORS);
+  char* column_text = strtok(NULL, TOKEN_SEPARATORS);
+  char* orientation_text = strtok(NULL, TOKEN_SEPARATORS);
+  char* word_text = strtok(NULL, TOKEN_SEPARATORS);
+  if((command == NULL) || (strcmp(command, insert_command) != 0) ||
+     (word_text == NULL) || (strtok(NULL, TOKEN_SEPARATORS) != NULL) ||
+     (orientation_text[1] != eos) ||
+     ((orientation_text[0] != horizontal) &&
+      (orientation_text[0] != vertical)))
+  {
+    free(input_copy);
+    return 0;
+  }
+  int row_value = parseFieldCoordinate(row_text);
+  int column_value = parseFieldCoordinate(column_text);
+  size_t word_size = strlen(word_text) + 1;
+  char* word = (char*)malloc(word_size * sizeof(char));
+  if((row_value < 0) || (column_value < 0) || (word == NULL))
+  {
+    free(word);
+    free(input_copy);
+    return 0;
   }
-  return word_points;
+  memcpy(word, word_text, word_size);
+  int orientation = (orientation_text[0] == vertical);
+  free(input_copy);
+
+  // on errors the framework does not hand out a word
+  if(!player_input->is_error_)
+    free(player_input->word_);
+  player_input->command_ = INSERT;
+  player_input->is_error_ = 0;
+  player_input->orientation_ = orientation;
+  player_input->word_ = word;
+  *row = row_value;
+  *column = column_value;
+  return 1;
 }
 
 //------------------------------------------------------------------------------
 ///
-/// In the function gamePlayInsertCommand, we implement the insert command
-/// logic and its needed checks.
+/// In the function loadFieldLine, we copy one row or one column of the game
+/// field into a flat buffer, so it can be compared with vector instructions.
+/// Letters are lowercased, the rest of the buffer is filled with eos, which
+/// never matches a letter or a space. Inlined into the fixed size board
+/// kernels.
 ///
 /// @param game_play_field holds the current state of the game field.
 /// @param field_size holds the size of the field.
-/// @param player_input the given input.
-/// @param char_points_string used to get the amount of points per each input.
-/// @param points_won
+/// @param line_index the row (horizontal) or column (vertical) to load.
+/// @param orientation 0 to load a row, otherwise a column.
+/// @param field_line buffer of FIELD_LINE_BUFFER chars receiving the line.
 ///
-/// @return SUCCESS if no problems were detected.
-/// @return return_value
+/// @return
 //
-int gamePlayInsertCommand(Word** game_play_field, Input* player_input,
-                          char* char_points_string, int field_size,
-                          int* points_won)
+BOARD_KERNEL_INLINE void loadFieldLine(Word** game_play_field, int field_size,
+                                       int line_index, int orientation,
+                                       char* field_line)
 {
   char eos = '\0';
+  int lower_case_bit = 32;
+
+  memset(field_line, eos, FIELD_LINE_BUFFER);
+  int line_iterator = 0;
+  for(line_iterator = 0; line_iterator < field_size; line_iterator++)
+  {
+    char field_char = 0;
+    if(orientation)
+      field_char = game_play_field[line_iterator][line_index].letter_;
+    else
+      field_char = game_play_field[line_index][line_iterator].letter_;
+    field_line[line_iterator] = (char)(field_char | lower_case_bit);
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function segmentCharMask, we compare SEGMENT_VECTOR_SIZE chars of
+/// a segment against one letter. Uses AVX2 or SSE2 if the compiler targets
+/// them and falls back to a plain loop otherwise.
+///
+/// @param segment at least SEGMENT_VECTOR_SIZE readable chars.
+/// @param letter the letter to look for.
+///
+/// @return char_mask with bit i set if segment[i] equals letter.
+//
+unsigned int segmentCharMask(const char* segment, char letter)
+{
+#if defined(__AVX2__)
+  __m256i line = _mm256_loadu_si256((const __m256i*)segment);
+  __m256i letters = _mm256_set1_epi8(letter);
+  return (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(line, letters));
+#elif defined(__SSE2__)
+  int half_vector = SEGMENT_VECTOR_SIZE / 2;
+  __m128i letters = _mm_set1_epi8(letter);
+  __m128i low_line = _mm_loadu_si128((const __m128i*)segment);
+  __m128i high_line = _mm_loadu_si128((const __m128i*)(segment + half_vector));
+  unsigned int low_mask =
+      (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(low_line, letters));
+  unsigned int high_mask =
+      (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(high_line, letters));
+  return low_mask | (high_mask << half_vector);
+#else
+  unsigned int char_mask = 0;
+  int segment_iterator = 0;
+  for(segment_iterator = 0; segment_iterator < SEGMENT_VECTOR_SIZE;
+      segment_iterator++)
+  {
+    if(segment[segment_iterator] == letter)
+      char_mask |= 1u << segment_iterator;
+  }
+  return char_mask;
+#endif
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function segmentMatchCheck, we compare a word against the field
+/// segment it would be placed on, SEGMENT_VECTOR_SIZE cells at a time.
+///
+/// @param segment lowercased field cells, readable up to word_size rounded
+///                up to SEGMENT_VECTOR_SIZE.
+/// @param word lowercased word, readable up to the same length.
+/// @param word_size the number of letters in the word.
+///
+/// @return segment_flags a combination of SEGMENT_CONFLICT (a cell holds
+///         another letter), SEGMENT_OVERLAP (a cell holds the same letter)
+///         and SEGMENT_EMPTY (all cells are free).
+//
+int segmentMatchCheck(const char* segment, const char* word, int word_size)
+{
   char space = ' ';
-  int char_to_coordinate = 97;
+  unsigned int full_mask = 0xFFFFFFFFu;
+  int segment_flags = SEGMENT_EMPTY;
 
-  int return_value = wordPlacementCheck(game_play_field, player_input,
-                                        char_points_string, field_size);
-  if(return_value != SUCCESS)
-    return return_value;
+  int block = 0;
+  for(block = 0; block < word_size; block += SEGMENT_VECTOR_SIZE)
+  {
+    int remaining = word_size - block;
+    unsigned int length_mask = full_mask;
+    if(remaining < SEGMENT_VECTOR_SIZE)
+      length_mask = (1u << remaining) - 1u;
+
+    unsigned int empty_mask = segmentCharMask(segment + block, space);
+    unsigned int equal_mask = 0;
+#if defined(__AVX2__)
+    __m256i line = _mm256_loadu_si256((const __m256i*)(segment + block));
+    __m256i letters = _mm256_loadu_si256((const __m256i*)(word + block));
+    equal_mask =
+        (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(line, letters));
+#elif defined(__SSE2__)
+    int half_vector = SEGMENT_VECTOR_SIZE / 2;
+    __m128i low_line = _mm_loadu_si128((const __m128i*)(segment + block));
+    __m128i high_line =
+        _mm_loadu_si128((const __m128i*)(segment + block + half_vector));
+    __m128i low_letters = _mm_loadu_si128((const __m128i*)(word + block));
+    __m128i high_letters =
+        _mm_loadu_si128((const __m128i*)(word + block + half_vector));
+    equal_mask =
+        (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(low_line, low_letters))
+        | ((unsigned int)_mm_movemask_epi8(
+              _mm_cmpeq_epi8(high_line, high_letters)) << half_vector);
+#else
+    int segment_iterator = 0;
+    for(segment_iterator = 0; segment_iterator < SEGMENT_VECTOR_SIZE;
+        segment_iterator++)
+    {
+      if(segment[block + segment_iterator] == word[block + segment_iterator])
+        equal_mask |= 1u << segment_iterator;
+    }
+#endif
+    if(~(equal_mask | empty_mask) & length_mask)
+      segment_flags |= SEGMENT_CONFLICT;
+    if(equal_mask & length_mask)
+      segment_flags |= SEGMENT_OVERLAP;
+    if(~empty_mask & length_mask)
+      segment_flags &= ~SEGMENT_EMPTY;
+  }
+  return segment_flags;
+}
 
-  int row_coordinate = player_input->row_ - char_to_coordinate;
-  int column_coordinate = player_input->column_ - char_to_coordinate;
+//------------------------------------------------------------------------------
+///
+/// In the function segmentMatchAllOffsets, we test one word at every start
+/// offset of a field line at once. For every letter of the word the line is
+/// compared against that letter, and the resulting mask is shifted back by
+/// the letter position, so bit s of each result describes the placement
+/// starting at offset s. Starts where the word does not fit are dropped.
+///
+/// @param field_line line loaded by loadFieldLine.
+/// @param line_size the number of cells in the line, at most
+///                  SEGMENT_VECTOR_SIZE.
+/// @param word lowercased word.
+/// @param word_size the number of letters in the word.
+/// @param conflict_starts starts where a cell holds another letter.
+/// @param overlap_starts starts where a cell holds the same letter.
+/// @param occupied_starts starts where at least one cell is not free.
+///
+/// @return
+//
+void segmentMatchAllOffsets(const char* field_line, int line_size,
+                            const char* word, int word_size,
+                            unsigned int* conflict_starts,
+                            unsigned int* overlap_starts,
+                            unsigned int* occupied_starts)
+{
+  char space = ' ';
+  *conflict_starts = 0;
+  *overlap_starts = 0;
+  *occupied_starts = 0;
+  if((word_size <= 0) || (word_size > line_size) ||
+     (line_size > SEGMENT_VECTOR_SIZE))
+    return;
 
+  unsigned int empty_mask = segmentCharMask(field_line, space);
   int word_iterator = 0;
-  for(word_iterator = 0; player_input->word_[word_iterator] != eos;
-      word_iterator++)
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
   {
-    char word_char = (char)toupper(player_input->word_[word_iterator]);
-    int letter_points = pointLetterInput(player_input->word_[word_iterator],
-                                         char_points_string);
-    if(game_play_field[row_coordinate][column_coordinate].letter_ == space)
-      *points_won += letter_points;
-    game_play_field[row_coordinate][column_coordinate].letter_ = word_char;
-    game_play_field[row_coordinate][column_coordinate].letter_points_ =
-        letter_points;
+    unsigned int equal_mask = segmentCharMask(field_line, word[word_iterator]);
+    *conflict_starts |= ~(equal_mask | empty_mask) >> word_iterator;
+    *overlap_starts |= equal_mask >> word_iterator;
+    *occupied_starts |= ~empty_mask >> word_iterator;
+  }
 
-    if(player_input->orientation_)
-      row_coordinate++;
-    else
-      column_coordinate++;
+  int start_count = line_size - word_size + 1;
+  unsigned int start_mask = 0xFFFFFFFFu;
+  if(start_count < SEGMENT_VECTOR_SIZE)
+    start_mask = (1u << start_count) - 1u;
+  *conflict_starts &= start_mask;
+  *overlap_starts &= start_mask;
+  *occupied_starts &= start_mask;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printGameField, we print the column letters and the rows
+/// of the game field with their row letter. Every row is built in a buffer
+/// and written at once.
+/// Inlined into the fixed size board kernels.
+///
+/// @param game_play_field holds the actual state of the game field.
+/// @param field_size holds the size of the field.
+///
+/// @return
+//
+BOARD_KERNEL_INLINE void printGameField(Word** game_play_field,
+                                        int field_size)
+{
+  // print upper part of field
+  int print_iterator = 0;
+  int start_letter = 65;
+  for(print_iterator = 0; print_iterator < field_size; print_iterator++)
+  {
+    if(print_iterator == 0)
+      printf(" |");
+    printf("%c", start_letter + print_iterator);
+  }
+  printf("\n");
+  int new_field_size = field_size + 2;
+  for(print_iterator = 0; print_iterator < new_field_size; print_iterator++)
+    printf("-");
+  printf("\n");
+
+  // print field content
+  char start_letter_a = 'A';
+  char separator = '|';
+  char new_line = '\n';
+  int row_prefix = 2;
+  char field_row[MAX_FIELD_SIZE + 3];
+
+  int outer_iterator = 0;
+  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
+  {
+    field_row[0] = (char)(start_letter_a + outer_iterator);
+    field_row[1] = separator;
+    int inner_iterator = 0;
+    for(inner_iterator = 0; inner_iterator < field_size; inner_iterator++)
+    {
+      field_row[row_prefix + inner_iterator] =
+          game_play_field[outer_iterator][inner_iterator].letter_;
+    }
+    field_row[row_prefix + field_size] = new_line;
+    fwrite(field_row, sizeof(char), row_prefix + field_size + 1, stdout);
+  }
+}
+
+// One set of board kernels per field size. The generic functions above are
+// inlined with SIZE as a constant, so every loop has a fixed bound and can
+// be unrolled and vectorized by the compiler. The field_size parameter only
+// keeps the signatures shared between all kernels.
+#define DEFINE_BOARD_KERNELS(SIZE) \
+  int checkEmptyField##SIZE(Word** game_play_field, int field_size) \
+  { \
+    (void)field_size; \
+    return checkEmptyField(game_play_field, SIZE); \
+  } \
+  void loadFieldLine##SIZE(Word** game_play_field, int field_size, \
+                           int line_index, int orientation, \
+                           char* field_line) \
+  { \
+    (void)field_size; \
+    loadFieldLine(game_play_field, SIZE, line_index, orientation, \
+                  field_line); \
+  } \
+  void printGameField##SIZE(Word** game_play_field, int field_size) \
+  { \
+    (void)field_size; \
+    printGameField(game_play_field, SIZE); \
+  }
+
+#define BOARD_KERNELS_ENTRY(SIZE) \
+  { SIZE, createDenseField, freeDenseField, denseFieldCell, \
+    checkEmptyField##SIZE, loadFieldLine##SIZE, loadDenseSegment, \
+    printGameField##SIZE }
+
+DEFINE_BOARD_KERNELS(4)
+DEFINE_BOARD_KERNELS(5)
+DEFINE_BOARD_KERNELS(6)
+DEFINE_BOARD_KERNELS(7)
+DEFINE_BOARD_KERNELS(8)
+DEFINE_BOARD_KERNELS(9)
+DEFINE_BOARD_KERNELS(10)
+DEFINE_BOARD_KERNELS(11)
+DEFINE_BOARD_KERNELS(12)
+DEFINE_BOARD_KERNELS(13)
+DEFINE_BOARD_KERNELS(14)
+DEFINE_BOARD_KERNELS(15)
+DEFINE_BOARD_KERNELS(16)
+DEFINE_BOARD_KERNELS(17)
+DEFINE_BOARD_KERNELS(18)
+DEFINE_BOARD_KERNELS(19)
+DEFINE_BOARD_KERNELS(20)
+DEFINE_BOARD_KERNELS(21)
+DEFINE_BOARD_KERNELS(22)
+DEFINE_BOARD_KERNELS(23)
+DEFINE_BOARD_KERNELS(24)
+DEFINE_BOARD_KERNELS(25)
+DEFINE_BOARD_KERNELS(26)
+
+// indexed by field_size - MIN_FIELD_SIZE
+const BoardKernels board_kernels_table[] = {
+  BOARD_KERNELS_ENTRY(4), BOARD_KERNELS_ENTRY(5), BOARD_KERNELS_ENTRY(6),
+  BOARD_KERNELS_ENTRY(7), BOARD_KERNELS_ENTRY(8), BOARD_KERNELS_ENTRY(9),
+  BOARD_KERNELS_ENTRY(10), BOARD_KERNELS_ENTRY(11), BOARD_KERNELS_ENTRY(12),
+  BOARD_KERNELS_ENTRY(13), BOARD_KERNELS_ENTRY(14), BOARD_KERNELS_ENTRY(15),
+  BOARD_KERNELS_ENTRY(16), BOARD_KERNELS_ENTRY(17), BOARD_KERNELS_ENTRY(18),
+  BOARD_KERNELS_ENTRY(19), BOARD_KERNELS_ENTRY(20), BOARD_KERNELS_ENTRY(21),
+  BOARD_KERNELS_ENTRY(22), BOARD_KERNELS_ENTRY(23), BOARD_KERNELS_ENTRY(24),
+  BOARD_KERNELS_ENTRY(25), BOARD_KERNELS_ENTRY(26)
+};
+
+// fields bigger than MAX_FIELD_SIZE, field_size_ is set by getBoardKernels
+const BoardKernels chunked_board_kernels = {
+  0, createChunkedField, freeChunkedField, chunkedFieldCell,
+  checkEmptyChunkedField, NULL, loadChunkedSegment, printChunkedField
+};
+
+//------------------------------------------------------------------------------
+///
+/// In the function getBoardKernels, we select the board kernels for a field
+/// size. It is called once when the game starts, the field size was already
+/// checked by configToArray.
+///
+/// @param field_size holds the size of the field.
+/// @param board_kernels receives the kernels for field_size.
+///
+/// @return
+//
+void getBoardKernels(int field_size, BoardKernels* board_kernels)
+{
+  if(field_size > MAX_FIELD_SIZE)
+  {
+    *board_kernels = chunked_board_kernels;
+    board_kernels->field_size_ = field_size;
+    return;
+  }
+  *board_kernels = board_kernels_table[field_size - MIN_FIELD_SIZE];
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function createDenseField, we allocate a free field as an array
+/// of rows.
+///
+/// @param field_size holds the size of the field.
+///
+/// @return NULL in case of problems.
+/// @return game_play_field with a space in every cell.
+//
+Word** createDenseField(int field_size)
+{
+  char space = ' ';
+
+  Word** game_play_field = (Word**)malloc(field_size * sizeof(Word*));
+  if(game_play_field == NULL)
+    return NULL;
+
+  int outer_iterator = 0;
+  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
+  {
+    Word* game_play_row = (Word*)malloc(field_size * sizeof(Word));
+    if(game_play_row == NULL)
+    {
+      freeDenseField(game_play_field, outer_iterator);
+      return NULL;
+    }
+
+    int inner_iterator = 0;
+    for(inner_iterator = 0; inner_iterator < field_size; inner_iterator++)
+    {
+      game_play_row[inner_iterator].letter_ = space;
+      game_play_row[inner_iterator].letter_points_ = 0;
+    }
+    game_play_field[outer_iterator] = game_play_row;
+  }
+  return game_play_field;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function freeDenseField, we free a field created by
+/// createDenseField.
+///
+/// @param game_play_field the field to free.
+/// @param field_size the number of allocated rows.
+///
+/// @return
+//
+void freeDenseField(Word** game_play_field, int field_size)
+{
+  int outer_iterator = 0;
+  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
+    free(game_play_field[outer_iterator]);
+  free(game_play_field);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function denseFieldCell, we get a cell of a dense field. All
+/// cells exist, so nothing is ever allocated.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param field_size holds the size of the field.
+/// @param row the row of the cell.
+/// @param column the column of the cell.
+/// @param allocate unused.
+///
+/// @return field_cell the cell.
+//
+Word* denseFieldCell(Word** game_play_field, int field_size, int row,
+                     int column, int allocate)
+{
+  (void)field_size;
+  (void)allocate;
+  return &game_play_field[row][column];
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function loadDenseSegment, we copy the cells below a word into a
+/// flat buffer for segmentMatchCheck. Letters are lowercased and the buffer
+/// is padded with SEGMENT_VECTOR_SIZE eos chars.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param field_size holds the size of the field.
+/// @param row the row of the first cell.
+/// @param column the column of the first cell.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param length the number of cells to copy.
+/// @param segment receives length + SEGMENT_VECTOR_SIZE chars.
+///
+/// @return
+//
+void loadDenseSegment(Word** game_play_field, int field_size, int row,
+                      int column, int orientation, int length, char* segment)
+{
+  char eos = '\0';
+  int lower_case_bit = 32;
+  (void)field_size;
+
+  int segment_iterator = 0;
+  for(segment_iterator = 0; segment_iterator < length; segment_iterator++)
+  {
+    char field_char = 0;
+    if(orientation)
+      field_char = game_play_field[row + segment_iterator][column].letter_;
+    else
+      field_char = game_play_field[row][column + segment_iterator].letter_;
+    segment[segment_iterator] = (char)(field_char | lower_case_bit);
+  }
+  memset(segment + length, eos, SEGMENT_VECTOR_SIZE);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function createChunkedField, we allocate the chunk directory of
+/// a large field. No chunk is allocated yet, so the memory of a free field
+/// only depends on the number of chunks.
+///
+/// @param field_size holds the size of the field.
+///
+/// @return NULL in case of problems.
+/// @return game_play_field the chunk directory.
+//
+Word** createChunkedField(int field_size)
+{
+  int chunks_per_line = (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+  return (Word**)calloc(chunks_per_line * chunks_per_line, sizeof(Word*));
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function freeChunkedField, we free the chunk directory and all
+/// allocated chunks.
+///
+/// @param game_play_field the field to free.
+/// @param field_size holds the size of the field.
+///
+/// @return
+//
+void freeChunkedField(Word** game_play_field, int field_size)
+{
+  int chunks_per_line = (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+  int chunk_count = chunks_per_line * chunks_per_line;
+  int chunk_iterator = 0;
+  for(chunk_iterator = 0; chunk_iterator < chunk_count; chunk_iterator++)
+    free(game_play_field[chunk_iterator]);
+  free(game_play_field);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function chunkedFieldCell, we get a cell of a large field. The
+/// chunk holding the cell is allocated on the first write.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param field_size holds the size of the field.
+/// @param row the row of the cell.
+/// @param column the column of the cell.
+/// @param allocate 1 to allocate a missing chunk.
+///
+/// @return NULL if the chunk does not exist or could not be allocated.
+/// @return field_cell the cell.
+//
+Word* chunkedFieldCell(Word** game_play_field, int field_size, int row,
+                       int column, int allocate)
+{
+  char space = ' ';
+  int chunks_per_line = (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+  Word** field_chunk = &game_play_field[(row / FIELD_CHUNK_SIZE) *
+                                        chunks_per_line +
+                                        column / FIELD_CHUNK_SIZE];
+  if(*field_chunk == NULL)
+  {
+    if(!allocate)
+      return NULL;
+    Word* new_chunk = (Word*)malloc(FIELD_CHUNK_CELLS * sizeof(Word));
+    if(new_chunk == NULL)
+      return NULL;
+    int cell_iterator = 0;
+    for(cell_iterator = 0; cell_iterator < FIELD_CHUNK_CELLS; cell_iterator++)
+    {
+      new_chunk[cell_iterator].letter_ = space;
+      new_chunk[cell_iterator].letter_points_ = 0;
+    }
+    *field_chunk = new_chunk;
+  }
+  return &(*field_chunk)[(row % FIELD_CHUNK_SIZE) * FIELD_CHUNK_SIZE +
+                         column % FIELD_CHUNK_SIZE];
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function checkEmptyChunkedField, we check if a large field is
+/// empty. Only allocated chunks can hold letters.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param field_size holds the size of the field.
+///
+/// @return SUCCESS if a letter was found.
+/// @return empty_field if no letters are found.
+//
+int checkEmptyChunkedField(Word** game_play_field, int field_size)
+{
+  char space = ' ';
+  int empty_field = 1;
+  int chunks_per_line = (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+  int chunk_count = chunks_per_line * chunks_per_line;
+
+  int chunk_iterator = 0;
+  for(chunk_iterator = 0; chunk_iterator < chunk_count; chunk_iterator++)
+  {
+    Word* field_chunk = game_play_field[chunk_iterator];
+    if(field_chunk == NULL)
+      continue;
+    int cell_iterator = 0;
+    for(cell_iterator = 0; cell_iterator < FIELD_CHUNK_CELLS; cell_iterator++)
+    {
+      if(field_chunk[cell_iterator].letter_ != space)
+        return SUCCESS;
+    }
+  }
+  return empty_field;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function loadChunkedSegment, we copy the cells below a word of a
+/// large field into a flat buffer, one chunk lookup per FIELD_CHUNK_SIZE
+/// cells. Missing chunks are copied as spaces.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param field_size holds the size of the field.
+/// @param row the row of the first cell.
+/// @param column the column of the first cell.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param length the number of cells to copy.
+/// @param segment receives length + SEGMENT_VECTOR_SIZE chars.
+///
+/// @return
+//
+void loadChunkedSegment(Word** game_play_field, int field_size, int row,
+                        int column, int orientation, int length,
+                        char* segment)
+{
+  char eos = '\0';
+  char space = ' ';
+  int lower_case_bit = 32;
+  int chunks_per_line = (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+
+  int segment_iterator = 0;
+  while(segment_iterator < length)
+  {
+    int cell_row = row;
+    int cell_column = column;
+    int chunk_offset = 0;
+    if(orientation)
+    {
+      cell_row += segment_iterator;
+      chunk_offset = cell_row % FIELD_CHUNK_SIZE;
+    }
+    else
+    {
+      cell_column += segment_iterator;
+      chunk_offset = cell_column % FIELD_CHUNK_SIZE;
+    }
+    int chunk_cells = FIELD_CHUNK_SIZE - chunk_offset;
+    if(chunk_cells > length - segment_iterator)
+      chunk_cells = length - segment_iterator;
+
+    Word* field_chunk = game_play_field[(cell_row / FIELD_CHUNK_SIZE) *
+                                        chunks_per_line +
+                                        cell_column / FIELD_CHUNK_SIZE];
+    if(field_chunk == NULL)
+    {
+      memset(segment + segment_iterator, space, chunk_cells);
+    }
+    else
+    {
+      int cell_index = (cell_row % FIELD_CHUNK_SIZE) * FIELD_CHUNK_SIZE +
+                       cell_column % FIELD_CHUNK_SIZE;
+      int cell_step = 1;
+      if(orientation)
+        cell_step = FIELD_CHUNK_SIZE;
+      int cell_iterator = 0;
+      for(cell_iterator = 0; cell_iterator < chunk_cells; cell_iterator++)
+      {
+        segment[segment_iterator + cell_iterator] = (char)(
+            field_chunk[cell_index].letter_ | lower_case_bit);
+        cell_index += cell_step;
+      }
+    }
+    segment_iterator += chunk_cells;
+  }
+  memset(segment + length, eos, SEGMENT_VECTOR_SIZE);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printChunkedField, we print the part of a large field
+/// which holds letters, at most PRINT_WINDOW_SIZE rows and columns from its
+/// upper left letter. Column coordinates are written top down.
+///
+/// @param game_play_field holds the actual state of the game field.
+/// @param field_size holds the size of the field.
+///
+/// @return
+//
+void printChunkedField(Word** game_play_field, int field_size)
+{
+  char space = ' ';
+  int chunks_per_line = (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+  int first_row = field_size;
+  int first_column = field_size;
+  int last_row = -1;
+  int last_column = -1;
+
+  // find the letters, only allocated chunks are scanned
+  int chunk_iterator = 0;
+  for(chunk_iterator = 0; chunk_iterator < chunks_per_line * chunks_per_line;
+      chunk_iterator++)
+  {
+    Word* field_chunk = game_play_field[chunk_iterator];
+    if(field_chunk == NULL)
+      continue;
+    int cell_iterator = 0;
+    for(cell_iterator = 0; cell_iterator < FIELD_CHUNK_CELLS; cell_iterator++)
+    {
+      if(field_chunk[cell_iterator].letter_ == space)
+        continue;
+      int cell_row = (chunk_iterator / chunks_per_line) * FIELD_CHUNK_SIZE +
+                     cell_iterator / FIELD_CHUNK_SIZE;
+      int cell_column = (chunk_iterator % chunks_per_line) * FIELD_CHUNK_SIZE +
+                        cell_iterator % FIELD_CHUNK_SIZE;
+      if(cell_row < first_row)
+        first_row = cell_row;
+      if(cell_row > last_row)
+        last_row = cell_row;
+      if(cell_column < first_column)
+        first_column = cell_column;
+      if(cell_column > last_column)
+        last_column = cell_column;
+    }
+  }
+  if(last_row < 0)
+  {
+    printf("Field %dx%d is empty\n", field_size, field_size);
+    return;
+  }
+  if(last_row >= first_row + PRINT_WINDOW_SIZE)
+    last_row = first_row + PRINT_WINDOW_SIZE - 1;
+  if(last_column >= first_column + PRINT_WINDOW_SIZE)
+    last_column = first_column + PRINT_WINDOW_SIZE - 1;
+
+  // print column coordinates right aligned, one letter per line
+  char coordinate_text[MAX_COORDINATE_LENGTH + 1];
+  int text_line = 0;
+  for(text_line = 0; text_line < MAX_COORDINATE_LENGTH; text_line++)
+  {
+    printf("%*s|", MAX_COORDINATE_LENGTH, "");
+    int print_column = 0;
+    for(print_column = first_column; print_column <= last_column;
+        print_column++)
+    {
+      formatFieldCoordinate(print_column, coordinate_text);
+      int text_offset = MAX_COORDINATE_LENGTH - (int)strlen(coordinate_text);
+      if(text_line < text_offset)
+        printf("%c", space);
+      else
+        printf("%c", coordinate_text[text_line - text_offset]);
+    }
+    printf("\n");
+  }
+  int line_length = MAX_COORDINATE_LENGTH + 2 + last_column - first_column;
+  int print_iterator = 0;
+  for(print_iterator = 0; print_iterator < line_length; print_iterator++)
+    printf("-");
+  printf("\n");
+
+  int print_row = 0;
+  for(print_row = first_row; print_row <= last_row; print_row++)
+  {
+    formatFieldCoordinate(print_row, coordinate_text);
+    printf("%*s|", MAX_COORDINATE_LENGTH, coordinate_text);
+    int print_column = 0;
+    for(print_column = first_column; print_column <= last_column;
+        print_column++)
+    {
+      Word* field_cell = chunkedFieldCell(game_play_field, field_size,
+                                          print_row, print_column, 0);
+      if(field_cell == NULL)
+        printf("%c", space);
+      else
+        printf("%c", field_cell->letter_);
+    }
+    printf("\n");
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function compareBatchKeys, we compare two sort keys for qsort.
+///
+/// @param first_key the first key.
+/// @param second_key the second key.
+///
+/// @return -1, 0 or 1 like strcmp.
+//
+int compareBatchKeys(const void* first_key, const void* second_key)
+{
+  unsigned long long first_value = *(const unsigned long long*)first_key;
+  unsigned long long second_value = *(const unsigned long long*)second_key;
+  if(first_value < second_value)
+    return -1;
+  if(first_value > second_value)
+    return 1;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function validateInsertBatch, we check many candidate inserts in
+/// one pass and compute the points fieldInsertWord would award. The
+/// candidates are visited sorted by the row or column they are placed on,
+/// so on fields up to MAX_FIELD_SIZE every line is loaded only once for all
+/// candidates on it. The field is not changed.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table the letters of the char points string.
+/// @param insert_batch the candidates, receives results_ and scores_.
+///
+/// @return SUCCESS if the batch was checked.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+//
+int validateInsertBatch(Word** game_play_field,
+                        const BoardKernels* board_kernels,
+                        const LetterTable* letter_table,
+                        InsertBatch* insert_batch)
+{
+  char eos = '\0';
+  char space = ' ';
+  char small_a = 'a';
+  int error_return_value = 1;
+  int index_bits = 32;
+  unsigned long long index_mask = 0xFFFFFFFFull;
+  int field_size = board_kernels->field_size_;
+  int batch_count = insert_batch->count_;
+  if(batch_count <= 0)
+    return SUCCESS;
+
+  // sort key: line of the candidate above its index, vertical lines after
+  // the rows and invalid coordinates at the end
+  unsigned long long* batch_keys = (unsigned long long*)malloc(
+      batch_count * sizeof(unsigned long long));
+  if(batch_keys == NULL)
+    return OUT_MEMORY_ERROR;
+  int batch_iterator = 0;
+  for(batch_iterator = 0; batch_iterator < batch_count; batch_iterator++)
+  {
+    int row = insert_batch->rows_[batch_iterator];
+    int column = insert_batch->columns_[batch_iterator];
+    unsigned long long line_key = 2ull * field_size;
+    if((row >= 0) && (row < field_size) && (column >= 0) &&
+       (column < field_size))
+    {
+      if(insert_batch->orientations_[batch_iterator])
+        line_key = (unsigned long long)(field_size + column);
+      else
+        line_key = (unsigned long long)row;
+    }
+    batch_keys[batch_iterator] =
+        (line_key << index_bits) | (unsigned long long)batch_iterator;
+  }
+  qsort(batch_keys, batch_count, sizeof(unsigned long long), compareBatchKeys);
+
+  int field_empty = board_kernels->check_empty_(game_play_field, field_size);
+  char field_line[FIELD_LINE_BUFFER];
+  char field_segment[FIELD_SEGMENT_BUFFER];
+  char word_segment[FIELD_SEGMENT_BUFFER];
+  unsigned long long loaded_line = ~0ull;
+
+  for(batch_iterator = 0; batch_iterator < batch_count; batch_iterator++)
+  {
+    unsigned long long line_key = batch_keys[batch_iterator] >> index_bits;
+    int batch_index = (int)(batch_keys[batch_iterator] & index_mask);
+    int row = insert_batch->rows_[batch_index];
+    int column = insert_batch->columns_[batch_index];
+    int orientation = insert_batch->orientations_[batch_index];
+    int word_size = insert_batch->word_sizes_[batch_index];
+    const char* word =
+        insert_batch->words_ + insert_batch->word_offsets_[batch_index];
+
+    int insert_points = 0;
+    int return_value = placementParameterCheck(field_size, row, column,
+                                               orientation, word, word_size,
+                                               letter_table);
+    if((return_value == SUCCESS) && field_empty)
+    {
+      int word_iterator = 0;
+      for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+        insert_points += letter_table->points_[word[word_iterator] - small_a];
+    }
+    else if(return_value == SUCCESS)
+    {
+      const char* segment = field_segment;
+      if(board_kernels->load_line_ != NULL)
+      {
+        int line_index = row;
+        int word_start_position = column;
+        if(orientation)
+        {
+          line_index = column;
+          word_start_position = row;
+        }
+        if(line_key != loaded_line)
+        {
+          board_kernels->load_line_(game_play_field, field_size, line_index,
+                                    orientation, field_line);
+          loaded_line = line_key;
+        }
+        segment = field_line + word_start_position;
+      }
+      else
+      {
+        board_kernels->load_segment_(game_play_field, field_size, row, column,
+                                     orientation, word_size, field_segment);
+      }
+      memcpy(word_segment, word, word_size);
+      memset(word_segment + word_size, eos, SEGMENT_VECTOR_SIZE);
+
+      int segment_flags = segmentMatchCheck(segment, word_segment, word_size);
+      if((segment_flags & SEGMENT_CONFLICT) ||
+         !(segment_flags & SEGMENT_OVERLAP))
+        return_value = error_return_value;
+
+      int word_iterator = 0;
+      for(word_iterator = 0;
+          (return_value == SUCCESS) && (word_iterator < word_size);
+          word_iterator++)
+      {
+        if(segment[word_iterator] == space)
+          insert_points +=
+              letter_table->points_[word[word_iterator] - small_a];
+      }
+    }
+    insert_batch->results_[batch_index] = return_value;
+    insert_batch->scores_[batch_index] = insert_points;
+  }
+
+  free(batch_keys);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function recheckFieldMoves, we check found moves with
+/// validateInsertBatch as if they were inserted now. Moves the insert
+/// would refuse are dropped, the others get the points it would award.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table the letters of the char points string.
+/// @param moves the moves, the kept ones are moved to the front.
+/// @param move_count the number of moves, receives the number kept.
+///
+/// @return SUCCESS if the moves were checked.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+//
+int recheckFieldMoves(Word** game_play_field,
+                      const BoardKernels* board_kernels,
+                      const LetterTable* letter_table, FieldMove* moves,
+                      int* move_count)
+{
+  // rows, columns, orientations, word offsets, word sizes, results, scores
+  int batch_arrays = 7;
+  int batch_count = *move_count;
+  if(batch_count <= 0)
+    return SUCCESS;
+  int* batch_values =
+      (int*)malloc(batch_arrays * batch_count * sizeof(int));
+  char* batch_words = (char*)malloc(batch_count * MOVE_WORD_SIZE);
+  if((batch_values == NULL) || (batch_words == NULL))
+  {
+    free(batch_values);
+    free(batch_words);
+    return OUT_MEMORY_ERROR;
+  }
+  int* rows = batch_values;
+  int* columns = rows + batch_count;
+  int* orientations = columns + batch_count;
+  int* word_offsets = orientations + batch_count;
+  int* word_sizes = word_offsets + batch_count;
+  InsertBatch insert_batch;
+  insert_batch.count_ = batch_count;
+  insert_batch.rows_ = rows;
+  insert_batch.columns_ = columns;
+  insert_batch.orientations_ = orientations;
+  insert_batch.word_offsets_ = word_offsets;
+  insert_batch.word_sizes_ = word_sizes;
+  insert_batch.words_ = batch_words;
+  insert_batch.results_ = word_sizes + batch_count;
+  insert_batch.scores_ = insert_batch.results_ + batch_count;
+  int move_iterator = 0;
+  for(move_iterator = 0; move_iterator < batch_count; move_iterator++)
+  {
+    rows[move_iterator] = moves[move_iterator].row_;
+    columns[move_iterator] = moves[move_iterator].column_;
+    orientations[move_iterator] = moves[move_iterator].orientation_;
+    word_offsets[move_iterator] = move_iterator * MOVE_WORD_SIZE;
+    word_sizes[move_iterator] = (int)strlen(moves[move_iterator].word_);
+    memcpy(batch_words + word_offsets[move_iterator],
+           moves[move_iterator].word_, MOVE_WORD_SIZE);
+  }
+  int return_value = validateInsertBatch(game_play_field, board_kernels,
+                                         letter_table, &insert_batch);
+  if(return_value == SUCCESS)
+  {
+    int kept_count = 0;
+    for(move_iterator = 0; move_iterator < batch_count; move_iterator++)
+    {
+      if(insert_batch.results_[move_iterator] != SUCCESS)
+        continue;
+      moves[kept_count] = moves[move_iterator];
+      moves[kept_count].points_ = insert_batch.scores_[move_iterator];
+      kept_count++;
+    }
+    *move_count = kept_count;
+  }
+  free(batch_values);
+  free(batch_words);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function createSaveSnapshot, we copy everything a save needs, so
+/// the game can go on while the snapshot is written. Only the letters are
+/// copied, chunk by chunk, and free chunks of large fields are skipped.
+///
+/// @param game_play_field holds the actual state of the game field.
+/// @param board_kernels board storage for the size of the field.
+/// @param char_points_string used to get the amount of points per each input.
+/// @param config_name name of config file.
+/// @param player1_points hold the value of the points for player 1.
+/// @param player2_points hold the value of the points for player 2.
+/// @param player_turn shows whos turn it is.
+///
+/// @return NULL in case of problems.
+/// @return save_snapshot the copied game state.
+//
+SaveSnapshot* createSaveSnapshot(Word** game_play_field,
+                                 const BoardKernels* board_kernels,
+                                 const char* char_points_string,
+                                 const char* config_name, int player1_points,
+                                 int player2_points, int player_turn)
+{
+  char space = ' ';
+  int allocate_cell = 0;
+  int field_size = board_kernels->field_size_;
+
+  SaveSnapshot* save_snapshot = (SaveSnapshot*)malloc(sizeof(SaveSnapshot));
+  if(save_snapshot == NULL)
+    return NULL;
+  save_snapshot->field_size_ = field_size;
+  save_snapshot->chunks_per_line_ =
+      (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+  save_snapshot->player1_points_ = player1_points;
+  save_snapshot->player2_points_ = player2_points;
+  save_snapshot->player_turn_ = player_turn;
+  save_snapshot->char_points_string_ = char_points_string;
+  save_snapshot->config_name_ = config_name;
+
+  int chunks_per_line = save_snapshot->chunks_per_line_;
+  save_snapshot->chunks_ =
+      (char**)calloc(chunks_per_line * chunks_per_line, sizeof(char*));
+  if(save_snapshot->chunks_ == NULL)
+  {
+    free(save_snapshot);
+    return NULL;
+  }
+
+  int chunk_iterator = 0;
+  for(chunk_iterator = 0; chunk_iterator < chunks_per_line * chunks_per_line;
+      chunk_iterator++)
+  {
+    int first_row = (chunk_iterator / chunks_per_line) * FIELD_CHUNK_SIZE;
+    int first_column = (chunk_iterator % chunks_per_line) * FIELD_CHUNK_SIZE;
+    if(board_kernels->cell_(game_play_field, field_size, first_row,
+                            first_column, allocate_cell) == NULL)
+      continue;
+
+    char* chunk_letters = (char*)malloc(FIELD_CHUNK_CELLS * sizeof(char));
+    if(chunk_letters == NULL)
+    {
+      freeSaveSnapshot(save_snapshot);
+      return NULL;
+    }
+    int cell_iterator = 0;
+    for(cell_iterator = 0; cell_iterator < FIELD_CHUNK_CELLS; cell_iterator++)
+    {
+      int cell_row = first_row + cell_iterator / FIELD_CHUNK_SIZE;
+      int cell_column = first_column + cell_iterator % FIELD_CHUNK_SIZE;
+      chunk_letters[cell_iterator] = space;
+      if((cell_row < field_size) && (cell_column < field_size))
+        chunk_letters[cell_iterator] = fieldLetter(
+            game_play_field, board_kernels, cell_row, cell_column);
+    }
+    save_snapshot->chunks_[chunk_iterator] = chunk_letters;
+  }
+  return save_snapshot;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function freeSaveSnapshot, we free a snapshot and its chunks.
+///
+/// @param save_snapshot the snapshot to free.
+///
+/// @return
+//
+void freeSaveSnapshot(SaveSnapshot* save_snapshot)
+{
+  int chunks_per_line = save_snapshot->chunks_per_line_;
+  int chunk_iterator = 0;
+  for(chunk_iterator = 0; chunk_iterator < chunks_per_line * chunks_per_line;
+      chunk_iterator++)
+    free(save_snapshot->chunks_[chunk_iterator]);
+  free(save_snapshot->chunks_);
+  free(save_snapshot);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function writeSaveSnapshot, we replace the config file with the
+/// snapshot through writeMappedFile, so a crash while saving leaves the old
+/// config whole. The config text is built in memory first.
+///
+/// @param save_snapshot the game state to write.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be written.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS if no problems were detected.
+//
+int writeSaveSnapshot(const SaveSnapshot* save_snapshot)
+{
+  char magic_nr[] = "Scrabble";
+  char space = ' ';
+  int field_size = save_snapshot->field_size_;
+  int chunks_per_line = save_snapshot->chunks_per_line_;
+
+  char* config_content = NULL;
+  size_t config_size = 0;
+  FILE* config_text = open_memstream(&config_content, &config_size);
+  if(config_text == NULL)
+    return OUT_MEMORY_ERROR;
+
+  fputs(magic_nr, config_text);
+  fputs("\n", config_text);
+
+  int outer_iterator = 0;
+  for(outer_iterator = 0; outer_iterator < field_size; outer_iterator++)
+  {
+    int inner_iterator = 0;
+    for(inner_iterator = 0; inner_iterator < field_size; inner_iterator++)
+    {
+      const char* chunk_letters = save_snapshot->chunks_[
+          (outer_iterator / FIELD_CHUNK_SIZE) * chunks_per_line +
+          inner_iterator / FIELD_CHUNK_SIZE];
+      if(chunk_letters == NULL)
+        fputc(space, config_text);
+      else
+        fputc(chunk_letters[(outer_iterator % FIELD_CHUNK_SIZE) *
+                            FIELD_CHUNK_SIZE +
+                            inner_iterator % FIELD_CHUNK_SIZE], config_text);
+    }
+    fputs("\n", config_text);
+  }
+  fprintf(config_text,"%d\n", save_snapshot->player_turn_);
+  fprintf(config_text,"%d\n", save_snapshot->player1_points_);
+  fprintf(config_text,"%d\n", save_snapshot->player2_points_);
+  fputs(save_snapshot->char_points_string_, config_text);
+
+  int return_value = OUT_MEMORY_ERROR;
+  if((fclose(config_text) == 0) && (config_content != NULL))
+    return_value = writeMappedFile(save_snapshot->config_name_,
+                                   (const unsigned char*)config_content,
+                                   config_size);
+  free(config_content);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function initializeSaveWriter, we prepare a save writer. The
+/// thread is only started by the first save.
+///
+/// @param save_writer the writer to prepare.
+///
+/// @return
+//
+void initializeSaveWriter(SaveWriter* save_writer)
+{
+  pthread_mutex_init(&save_writer->mutex_, NULL);
+  pthread_cond_init(&save_writer->condition_, NULL);
+  save_writer->started_ = 0;
+  save_writer->stop_ = 0;
+  save_writer->pending_ = NULL;
+  save_writer->submitted_saves_ = 0;
+  save_writer->durable_saves_ = 0;
+  save_writer->save_error_ = SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function submitSaveSnapshot, we hand a snapshot to the writer
+/// thread and return at once. A snapshot still waiting is replaced. If the
+/// thread cannot be started the snapshot is written right away.
+///
+/// @param save_writer the writer.
+/// @param save_snapshot the snapshot, owned by the writer afterwards.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if a direct write failed.
+/// @return SUCCESS otherwise.
+//
+int submitSaveSnapshot(SaveWriter* save_writer, SaveSnapshot* save_snapshot)
+{
+  pthread_mutex_lock(&save_writer->mutex_);
+  if(!save_writer->started_)
+  {
+    if(pthread_create(&save_writer->thread_, NULL, saveWriterThread,
+                      save_writer) != 0)
+    {
+      pthread_mutex_unlock(&save_writer->mutex_);
+      int return_value = writeSaveSnapshot(save_snapshot);
+      freeSaveSnapshot(save_snapshot);
+      return return_value;
+    }
+    save_writer->started_ = 1;
+  }
+  if(save_writer->pending_ != NULL)
+    freeSaveSnapshot(save_writer->pending_);
+  save_writer->pending_ = save_snapshot;
+  save_writer->submitted_saves_++;
+  pthread_cond_broadcast(&save_writer->condition_);
+  pthread_mutex_unlock(&save_writer->mutex_);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function saveWriterThread, we write the newest pending snapshot
+/// until the writer is stopped and nothing is pending anymore.
+///
+/// @param writer_argument the SaveWriter.
+///
+/// @return NULL
+//
+void* saveWriterThread(void* writer_argument)
+{
+  SaveWriter* save_writer = (SaveWriter*)writer_argument;
+
+  pthread_mutex_lock(&save_writer->mutex_);
+  while(1)
+  {
+    while((save_writer->pending_ == NULL) && !save_writer->stop_)
+      pthread_cond_wait(&save_writer->condition_, &save_writer->mutex_);
+    if(save_writer->pending_ == NULL)
+      break;
+
+    SaveSnapshot* save_snapshot = save_writer->pending_;
+    unsigned long written_saves = save_writer->submitted_saves_;
+    save_writer->pending_ = NULL;
+    pthread_mutex_unlock(&save_writer->mutex_);
+
+    int return_value = writeSaveSnapshot(save_snapshot);
+    freeSaveSnapshot(save_snapshot);
+
+    pthread_mutex_lock(&save_writer->mutex_);
+    save_writer->durable_saves_ = written_saves;
+    if(return_value != SUCCESS)
+      save_writer->save_error_ = return_value;
+    pthread_cond_broadcast(&save_writer->condition_);
+  }
+  pthread_mutex_unlock(&save_writer->mutex_);
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function saveWriterDurable, we report if every submitted save
+/// reached the disk. Saves replaced by a newer one count as written with it.
+///
+/// @param save_writer the writer.
+/// @param pending_saves receives the number of saves not on disk yet.
+/// @param durable_saves receives the number of saves on disk.
+///
+/// @return 1 if all saves are on disk, 0 otherwise.
+//
+int saveWriterDurable(SaveWriter* save_writer, unsigned long* pending_saves,
+                      unsigned long* durable_saves)
+{
+  pthread_mutex_lock(&save_writer->mutex_);
+  *durable_saves = save_writer->durable_saves_;
+  *pending_saves = save_writer->submitted_saves_ -
+                   save_writer->durable_saves_;
+  pthread_mutex_unlock(&save_writer->mutex_);
+  return *pending_saves == 0;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printSaveStatus, we print how many saves of the game
+/// reached the disk and how many are still being written.
+///
+/// @param game_state the running game.
+///
+/// @return
+//
+void printSaveStatus(GameState* game_state)
+{
+  unsigned long pending_saves = 0;
+  unsigned long durable_saves = 0;
+  saveWriterDurable(&game_state->save_writer_, &pending_saves,
+                    &durable_saves);
+  printf("Saves: %lu on disk, %lu pending\n", durable_saves, pending_saves);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function takeSaveWriterError, we get the error of a failed
+/// background save and reset it, so it is reported once.
+///
+/// @param save_writer the writer.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if a save failed since the last call.
+/// @return SUCCESS otherwise.
+//
+int takeSaveWriterError(SaveWriter* save_writer)
+{
+  pthread_mutex_lock(&save_writer->mutex_);
+  int save_error = save_writer->save_error_;
+  save_writer->save_error_ = SUCCESS;
+  pthread_mutex_unlock(&save_writer->mutex_);
+  return save_error;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function stopSaveWriter, we wait until the pending snapshot is
+/// written and stop the writer thread.
+///
+/// @param save_writer the writer.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if a save failed and was not reported.
+/// @return SUCCESS otherwise.
+//
+int stopSaveWriter(SaveWriter* save_writer)
+{
+  pthread_mutex_lock(&save_writer->mutex_);
+  save_writer->stop_ = 1;
+  pthread_cond_broadcast(&save_writer->condition_);
+  int started = save_writer->started_;
+  pthread_mutex_unlock(&save_writer->mutex_);
+  if(started)
+    pthread_join(save_writer->thread_, NULL);
+
+  pthread_mutex_destroy(&save_writer->mutex_);
+  pthread_cond_destroy(&save_writer->condition_);
+  return save_writer->save_error_;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function createDeltaStream, we create the file of a delta stream
+/// and map it shared, so viewers in other processes read the ring in
+/// place. The file is set up next to an old stream and renamed over it,
+/// viewers still mapping the old one keep reading it. The ring is big
+/// enough for a snapshot of a full field of field_size to take at most a
+/// quarter of it.
+///
+/// @param stream_name name of the stream file.
+/// @param field_size the size of the biggest field published.
+/// @param delta_stream receives the stream.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be written.
+/// @return SUCCESS otherwise.
+//
+int createDeltaStream(const char* stream_name, int field_size,
+                      DeltaStream* delta_stream)
+{
+  char temp_suffix[] = ".tmp";
+  memset(delta_stream, 0, sizeof(DeltaStream));
+  unsigned long long ring_size = DELTA_RING_SIZE;
+  unsigned long long snapshot_size =
+      (unsigned long long)field_size * field_size * DELTA_CELL_SIZE;
+  while(snapshot_size * 4 > ring_size)
+    ring_size *= 2;
+  size_t map_size = DELTA_STREAM_HEADER_SIZE + ring_size;
+
+  char* temp_name = (char*)malloc(strlen(stream_name) + sizeof(temp_suffix));
+  if(temp_name == NULL)
+    return OUT_MEMORY_ERROR;
+  strcpy(temp_name, stream_name);
+  strcat(temp_name, temp_suffix);
+  int stream_file = open(temp_name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  void* mapping = MAP_FAILED;
+  if((stream_file >= 0) && (ftruncate(stream_file, (off_t)map_size) == 0))
+    mapping = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   stream_file, 0);
+  if(stream_file >= 0)
+    close(stream_file);
+  if(mapping == MAP_FAILED)
+  {
+    remove(temp_name);
+    free(temp_name);
+    return CANNOT_OPEN_CONFIG_FILE;
+  }
+
+  delta_stream->header_ = (DeltaStreamHeader*)mapping;
+  delta_stream->ring_ = (unsigned char*)mapping + DELTA_STREAM_HEADER_SIZE;
+  delta_stream->ring_size_ = ring_size;
+  delta_stream->map_size_ = map_size;
+  delta_stream->writer_ = 1;
+  delta_stream->header_->ring_size_ = ring_size;
+  atomic_init(&delta_stream->header_->write_position_, 0);
+  atomic_init(&delta_stream->header_->snapshot_position_, 0);
+  atomic_init(&delta_stream->header_->finished_, 0);
+  memcpy(delta_stream->header_->magic_, DELTA_STREAM_MAGIC,
+         DELTA_STREAM_MAGIC_SIZE);
+  pthread_mutex_init(&delta_stream->write_mutex_, NULL);
+
+  int return_value = SUCCESS;
+  if(rename(temp_name, stream_name) != 0)
+  {
+    remove(temp_name);
+    closeDeltaStream(delta_stream);
+    return_value = CANNOT_OPEN_CONFIG_FILE;
+  }
+  free(temp_name);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function openDeltaStream, we map the file of a delta stream for
+/// reading.
+///
+/// @param stream_name name of the stream file.
+/// @param delta_stream receives the stream.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be opened.
+/// @return INVALID_CONFIG_FILE if the file is no delta stream.
+/// @return SUCCESS otherwise.
+//
+int openDeltaStream(const char* stream_name, DeltaStream* delta_stream)
+{
+  memset(delta_stream, 0, sizeof(DeltaStream));
+  int stream_file = open(stream_name, O_RDONLY);
+  if(stream_file < 0)
+    return CANNOT_OPEN_CONFIG_FILE;
+  struct stat stream_stat;
+  if((fstat(stream_file, &stream_stat) != 0) ||
+     (stream_stat.st_size < DELTA_STREAM_HEADER_SIZE + DELTA_RING_SIZE))
+  {
+    close(stream_file);
+    return INVALID_CONFIG_FILE;
+  }
+  size_t map_size = (size_t)stream_stat.st_size;
+  void* mapping = mmap(NULL, map_size, PROT_READ, MAP_SHARED, stream_file, 0);
+  close(stream_file);
+  if(mapping == MAP_FAILED)
+    return CANNOT_OPEN_CONFIG_FILE;
+
+  DeltaStreamHeader* header = (DeltaStreamHeader*)mapping;
+  if((memcmp(header->magic_, DELTA_STREAM_MAGIC, DELTA_STREAM_MAGIC_SIZE) !=
+      0) || (header->ring_size_ + DELTA_STREAM_HEADER_SIZE != map_size))
+  {
+    munmap(mapping, map_size);
+    return INVALID_CONFIG_FILE;
+  }
+  delta_stream->header_ = header;
+  delta_stream->ring_ = (unsigned char*)mapping + DELTA_STREAM_HEADER_SIZE;
+  delta_stream->ring_size_ = header->ring_size_;
+  delta_stream->map_size_ = map_size;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function closeDeltaStream, we unmap a delta stream. A writer
+/// marks the stream finished first, so viewers stop after the last record.
+///
+/// @param delta_stream the stream, may be unopened.
+///
+/// @return
+//
+void closeDeltaStream(DeltaStream* delta_stream)
+{
+  if(delta_stream->header_ == NULL)
+    return;
+  if(delta_stream->writer_)
+  {
+    atomic_store_explicit(&delta_stream->header_->finished_, 1,
+                          memory_order_release);
+    pthread_mutex_destroy(&delta_stream->write_mutex_);
+  }
+  munmap(delta_stream->header_, delta_stream->map_size_);
+  delta_stream->header_ = NULL;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function putDeltaValue, we store a number little endian.
+///
+/// @param record where the number is stored.
+/// @param value the number.
+/// @param bytes the number of bytes to store.
+///
+/// @return
+//
+void putDeltaValue(unsigned char* record, unsigned int value, int bytes)
+{
+  int byte_bits = 8;
+  int byte_iterator = 0;
+  for(byte_iterator = 0; byte_iterator < bytes; byte_iterator++)
+    record[byte_iterator] =
+        (unsigned char)(value >> (byte_iterator * byte_bits));
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function getDeltaValue, we read a number stored by putDeltaValue.
+///
+/// @param record where the number is stored.
+/// @param bytes the number of bytes to read.
+///
+/// @return value the number.
+//
+unsigned int getDeltaValue(const unsigned char* record, int bytes)
+{
+  int byte_bits = 8;
+  unsigned int value = 0;
+  int byte_iterator = 0;
+  for(byte_iterator = 0; byte_iterator < bytes; byte_iterator++)
+    value |= (unsigned int)record[byte_iterator] << (byte_iterator * byte_bits);
+  return value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function reserveDeltaRecord, we get the place for the next record.
+/// A record never wraps around the end of the ring, the rest of the ring is
+/// filled with a wrap record instead. Records are at most an eighth of the
+/// ring, so subscribers less than half a ring behind are never overwritten.
+/// The write lock has to be held.
+///
+/// @param delta_stream the stream.
+/// @param record_size the aligned size of the record.
+///
+/// @return NULL if the record is too big.
+/// @return record where the record has to be written.
+//
+unsigned char* reserveDeltaRecord(DeltaStream* delta_stream, int record_size)
+{
+  int size_bytes = 4;
+  unsigned long long ring_size = delta_stream->ring_size_;
+  if((unsigned long long)record_size > ring_size / 8)
+    return NULL;
+
+  unsigned long long write_position = atomic_load_explicit(
+      &delta_stream->header_->write_position_, memory_order_relaxed);
+  unsigned long long ring_offset = write_position % ring_size;
+  unsigned long long ring_rest = ring_size - ring_offset;
+  if(ring_rest < (unsigned long long)record_size)
+  {
+    unsigned char* wrap_record = delta_stream->ring_ + ring_offset;
+    putDeltaValue(wrap_record, (unsigned int)ring_rest, size_bytes);
+    wrap_record[size_bytes] = DELTA_RECORD_WRAP;
+    atomic_store_explicit(&delta_stream->header_->write_position_,
+                          write_position + ring_rest, memory_order_release);
+    ring_offset = 0;
+  }
+  return delta_stream->ring_ + ring_offset;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function commitDeltaRecord, we write the header of a reserved
+/// record and make it visible to the subscribers. The write lock has to be
+/// held.
+///
+/// @param delta_stream the stream.
+/// @param record the place returned by reserveDeltaRecord.
+/// @param record_size the aligned size of the record.
+/// @param record_type one of the DELTA_RECORD types.
+/// @param delta_game the game of the record.
+/// @param player_turn the player who moved or who moves next.
+/// @param cell_count the number of cells in the record.
+/// @param player1_points hold the value of the points for player 1.
+/// @param player2_points hold the value of the points for player 2.
+///
+/// @return
+//
+void commitDeltaRecord(DeltaStream* delta_stream, unsigned char* record,
+                       int record_size, int record_type,
+                       const DeltaGame* delta_game, int player_turn,
+                       int cell_count, int player1_points, int player2_points)
+{
+  putDeltaValue(record, (unsigned int)record_size, 4);
+  record[4] = (unsigned char)record_type;
+  record[5] = (unsigned char)player_turn;
+  putDeltaValue(record + 6, (unsigned int)cell_count, 2);
+  putDeltaValue(record + 8, (unsigned int)player1_points, 4);
+  putDeltaValue(record + 12, (unsigned int)player2_points, 4);
+  putDeltaValue(record + 16, delta_game->game_, 4);
+
+  // reserveDeltaRecord already moved past a wrap record
+  unsigned long long record_position = atomic_load_explicit(
+      &delta_stream->header_->write_position_, memory_order_relaxed);
+  atomic_store_explicit(&delta_stream->header_->write_position_,
+                        record_position + record_size, memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function publishMoveDelta, we publish the cells of a word which
+/// was just inserted, read back from the field. Every
+/// DELTA_SNAPSHOT_INTERVAL moves or sixteenth of the ring of a game a
+/// snapshot of it follows, so subscribers which fell behind can start
+/// again from there.
+///
+/// @param delta_stream the stream.
+/// @param delta_game the game which moved.
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param row first row of the word, counted from 0.
+/// @param column first column of the word, counted from 0.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param word_size the number of letters in the word.
+/// @param player1_points hold the value of the points for player 1.
+/// @param player2_points hold the value of the points for player 2.
+/// @param player_turn the player who inserted the word.
+///
+/// @return SUCCESS if the delta was published.
+/// @return error_return_value if the record does not fit into the ring.
+//
+int publishMoveDelta(DeltaStream* delta_stream, DeltaGame* delta_game,
+                     Word** game_play_field,
+                     const BoardKernels* board_kernels, int row, int column,
+                     int orientation, int word_size, int player1_points,
+                     int player2_points, int player_turn)
+{
+  int error_return_value = 1;
+  int record_size = DELTA_HEADER_SIZE + word_size * DELTA_CELL_SIZE;
+  record_size = (record_size + DELTA_RECORD_ALIGN - 1) /
+                DELTA_RECORD_ALIGN * DELTA_RECORD_ALIGN;
+  pthread_mutex_lock(&delta_stream->write_mutex_);
+  unsigned char* record = reserveDeltaRecord(delta_stream, record_size);
+  if(record == NULL)
+  {
+    pthread_mutex_unlock(&delta_stream->write_mutex_);
+    return error_return_value;
+  }
+
+  unsigned char* record_cell = record + DELTA_HEADER_SIZE;
+  int word_iterator = 0;
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+  {
+    putDeltaValue(record_cell, (unsigned int)row, 2);
+    putDeltaValue(record_cell + 2, (unsigned int)column, 2);
+    record_cell[4] = (unsigned char)fieldLetter(game_play_field,
+                                                board_kernels, row, column);
+    record_cell += DELTA_CELL_SIZE;
+    if(orientation)
+      row++;
+    else
+      column++;
+  }
+  commitDeltaRecord(delta_stream, record, record_size, DELTA_RECORD_MOVE,
+                    delta_game, player_turn, word_size, player1_points,
+                    player2_points);
+  pthread_mutex_unlock(&delta_stream->write_mutex_);
+
+  delta_game->moves_since_snapshot_++;
+  delta_game->bytes_since_snapshot_ += record_size;
+  if((delta_game->moves_since_snapshot_ >= DELTA_SNAPSHOT_INTERVAL) ||
+     ((unsigned long long)delta_game->bytes_since_snapshot_ >=
+      delta_stream->ring_size_ / 16))
+  {
+    int player_1 = 1;
+    int player_2 = 2;
+    int next_turn = player_1;
+    if(player_turn == player_1)
+      next_turn = player_2;
+    publishSnapshotDelta(delta_stream, delta_game, game_play_field,
+                         board_kernels, player1_points, player2_points,
+                         next_turn);
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function publishSnapshotDelta, we publish every letter on the
+/// field of a game. Free chunks of large fields are skipped. The letters
+/// are split into a snapshot record and as many snapshot part records as
+/// needed, all written under one lock so no other game comes in between.
+/// Subscribers which fell behind start again at the snapshot record.
+///
+/// @param delta_stream the stream.
+/// @param delta_game the game of the field.
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param player1_points hold the value of the points for player 1.
+/// @param player2_points hold the value of the points for player 2.
+/// @param player_turn the player who moves next.
+///
+/// @return SUCCESS if the snapshot was published.
+/// @return error_return_value if the ring is too small for a record.
+//
+int publishSnapshotDelta(DeltaStream* delta_stream, DeltaGame* delta_game,
+                         Word** game_play_field,
+                         const BoardKernels* board_kernels,
+                         int player1_points, int player2_points,
+                         int player_turn)
+{
+  char space = ' ';
+  int error_return_value = 1;
+  int allocate_cell = 0;
+  int max_cell_count = 0xFFFF;
+  int field_size = board_kernels->field_size_;
+  int chunks_per_line = (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+  int chunk_count = chunks_per_line * chunks_per_line;
+  delta_game->moves_since_snapshot_ = 0;
+  delta_game->bytes_since_snapshot_ = 0;
+
+  // every record is reserved for the most cells a record can take
+  int part_size = (int)(delta_stream->ring_size_ / 8);
+  part_size -= part_size % DELTA_RECORD_ALIGN;
+  int part_cells = (part_size - DELTA_HEADER_SIZE) / DELTA_CELL_SIZE;
+  if(part_cells > max_cell_count)
+    part_cells = max_cell_count;
+
+  pthread_mutex_lock(&delta_stream->write_mutex_);
+  unsigned char* record = reserveDeltaRecord(delta_stream, part_size);
+  if(record == NULL)
+  {
+    pthread_mutex_unlock(&delta_stream->write_mutex_);
+    return error_return_value;
+  }
+  unsigned long long snapshot_position = atomic_load_explicit(
+      &delta_stream->header_->write_position_, memory_order_relaxed);
+  int record_type = DELTA_RECORD_SNAPSHOT;
+  int cell_count = 0;
+  int chunk_iterator = 0;
+  for(chunk_iterator = 0; chunk_iterator <= chunk_count; chunk_iterator++)
+  {
+    int first_row = (chunk_iterator / chunks_per_line) * FIELD_CHUNK_SIZE;
+    int first_column = (chunk_iterator % chunks_per_line) * FIELD_CHUNK_SIZE;
+    if((chunk_iterator < chunk_count) &&
+       (board_kernels->cell_(game_play_field, field_size, first_row,
+                             first_column, allocate_cell) == NULL))
+      continue;
+    int cell_iterator = 0;
+    for(cell_iterator = 0; cell_iterator < FIELD_CHUNK_CELLS;
+        cell_iterator++)
+    {
+      // past the last cell only the last record is committed
+      int last_cell = (chunk_iterator == chunk_count);
+      int cell_row = first_row + cell_iterator / FIELD_CHUNK_SIZE;
+      int cell_column = first_column + cell_iterator % FIELD_CHUNK_SIZE;
+      char field_char = space;
+      if((!last_cell) && (cell_row < field_size) &&
+         (cell_column < field_size))
+        field_char = fieldLetter(game_play_field, board_kernels, cell_row,
+                                 cell_column);
+      if((cell_count == part_cells) ||
+         ((last_cell) && (cell_iterator == 0)))
+      {
+        int record_size = DELTA_HEADER_SIZE + cell_count * DELTA_CELL_SIZE;
+        record_size = (record_size + DELTA_RECORD_ALIGN - 1) /
+                      DELTA_RECORD_ALIGN * DELTA_RECORD_ALIGN;
+        commitDeltaRecord(delta_stream, record, record_size, record_type,
+                          delta_game, player_turn, cell_count,
+                          player1_points, player2_points);
+        if(last_cell)
+          break;
+        record = reserveDeltaRecord(delta_stream, part_size);
+        record_type = DELTA_RECORD_SNAPSHOT_PART;
+        cell_count = 0;
+      }
+      if(field_char == space)
+        continue;
+      unsigned char* record_cell =
+          record + DELTA_HEADER_SIZE + cell_count * DELTA_CELL_SIZE;
+      putDeltaValue(record_cell, (unsigned int)cell_row, 2);
+      putDeltaValue(record_cell + 2, (unsigned int)cell_column, 2);
+      record_cell[4] = (unsigned char)field_char;
+      cell_count++;
+    }
+  }
+  atomic_store_explicit(&delta_stream->header_->snapshot_position_,
+                        snapshot_position, memory_order_release);
+  pthread_mutex_unlock(&delta_stream->write_mutex_);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function publishGameEndDelta, we publish that a game ended.
+///
+/// @param delta_stream the stream.
+/// @param delta_game the game which ended.
+/// @param player1_points hold the value of the points for player 1.
+/// @param player2_points hold the value of the points for player 2.
+///
+/// @return
+//
+void publishGameEndDelta(DeltaStream* delta_stream,
+                         const DeltaGame* delta_game, int player1_points,
+                         int player2_points)
+{
+  int no_player = 0;
+  int record_size = (DELTA_HEADER_SIZE + DELTA_RECORD_ALIGN - 1) /
+                    DELTA_RECORD_ALIGN * DELTA_RECORD_ALIGN;
+  pthread_mutex_lock(&delta_stream->write_mutex_);
+  unsigned char* record = reserveDeltaRecord(delta_stream, record_size);
+  if(record != NULL)
+    commitDeltaRecord(delta_stream, record, record_size,
+                      DELTA_RECORD_GAME_END, delta_game, no_player, 0,
+                      player1_points, player2_points);
+  pthread_mutex_unlock(&delta_stream->write_mutex_);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function subscribeDeltaStream, we let a new subscriber start at
+/// the newest snapshot.
+///
+/// @param delta_stream the stream.
+/// @param delta_subscriber the subscriber to start.
+///
+/// @return
+//
+void subscribeDeltaStream(DeltaStream* delta_stream,
+                          DeltaSubscriber* delta_subscriber)
+{
+  delta_subscriber->read_position_ = atomic_load_explicit(
+      &delta_stream->header_->snapshot_position_, memory_order_acquire);
+  delta_subscriber->record_position_ = delta_subscriber->read_position_;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function readDeltaRecord, we get the next record of a subscriber
+/// in place, without copying it. A subscriber more than half a ring behind,
+/// or one which read a size the writer overwrote, is moved ahead to the
+/// newest snapshot.
+///
+/// @param delta_stream the stream.
+/// @param delta_subscriber the subscriber.
+/// @param record receives the record inside the ring.
+/// @param record_size receives the size of the record.
+///
+/// @return DELTA_RECORD_NONE if the subscriber read everything.
+/// @return record_type the type of the record.
+//
+int readDeltaRecord(DeltaStream* delta_stream,
+                    DeltaSubscriber* delta_subscriber,
+                    const unsigned char** record, int* record_size)
+{
+  int size_bytes = 4;
+  unsigned long long ring_size = delta_stream->ring_size_;
+  unsigned long long write_position = atomic_load_explicit(
+      &delta_stream->header_->write_position_, memory_order_acquire);
+  if(write_position - delta_subscriber->read_position_ > ring_size / 2)
+    subscribeDeltaStream(delta_stream, delta_subscriber);
+
+  while(delta_subscriber->read_position_ < write_position)
+  {
+    unsigned long long ring_offset =
+        delta_subscriber->read_position_ % ring_size;
+    const unsigned char* next_record = delta_stream->ring_ + ring_offset;
+    int next_size = (int)getDeltaValue(next_record, size_bytes);
+    int next_type = next_record[size_bytes];
+    if((next_size < DELTA_RECORD_ALIGN) ||
+       ((unsigned long long)next_size > ring_size - ring_offset))
+    {
+      subscribeDeltaStream(delta_stream, delta_subscriber);
+      return DELTA_RECORD_NONE;
+    }
+    delta_subscriber->record_position_ = delta_subscriber->read_position_;
+    delta_subscriber->read_position_ += next_size;
+    if(next_type == DELTA_RECORD_WRAP)
+      continue;
+    *record = next_record;
+    *record_size = next_size;
+    return next_type;
+  }
+  return DELTA_RECORD_NONE;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function deltaRecordOverwritten, we check if the last record a
+/// subscriber read in place could have been overwritten in the meantime.
+///
+/// @param delta_stream the stream.
+/// @param delta_subscriber the subscriber.
+///
+/// @return 1 if the record has to be dropped, 0 otherwise.
+//
+int deltaRecordOverwritten(DeltaStream* delta_stream,
+                           const DeltaSubscriber* delta_subscriber)
+{
+  unsigned long long write_position = atomic_load_explicit(
+      &delta_stream->header_->write_position_, memory_order_acquire);
+  return write_position - delta_subscriber->record_position_ >
+         delta_stream->ring_size_ / 2;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printDeltaRecord, we print one record of a delta stream
+/// as a line.
+///
+/// @param record the record.
+/// @param record_type the type of the record.
+///
+/// @return
+//
+void printDeltaRecord(const unsigned char* record, int record_type)
+{
+  char eos = '\0';
+  int player_turn = record[5];
+  int cell_count = (int)getDeltaValue(record + 6, 2);
+  unsigned int player1_points = getDeltaValue(record + 8, 4);
+  unsigned int player2_points = getDeltaValue(record + 12, 4);
+  unsigned int game = getDeltaValue(record + 16, 4);
+  const unsigned char* record_cell = record + DELTA_HEADER_SIZE;
+  if(record_type == DELTA_RECORD_MOVE)
+  {
+    char word[MOVE_WORD_SIZE];
+    int word_size = 0;
+    while((word_size < cell_count) && (word_size < MOVE_WORD_SIZE - 1))
+    {
+      word[word_size] = (char)record_cell[word_size * DELTA_CELL_SIZE + 4];
+      word_size++;
+    }
+    word[word_size] = eos;
+    char row_text[MAX_COORDINATE_LENGTH + 1];
+    char column_text[MAX_COORDINATE_LENGTH + 1];
+    formatFieldCoordinate((int)getDeltaValue(record_cell, 2), row_text);
+    formatFieldCoordinate((int)getDeltaValue(record_cell + 2, 2),
+                          column_text);
+    printf("Game %u: Player %d inserted %s at %s %s, %u:%u\n", game,
+           player_turn, word, row_text, column_text, player1_points,
+           player2_points);
+  }
+  else if(record_type == DELTA_RECORD_SNAPSHOT)
+    printf("Game %u: %d letters, Player %d to move, %u:%u\n", game,
+           cell_count, player_turn, player1_points, player2_points);
+  else if(record_type == DELTA_RECORD_SNAPSHOT_PART)
+    printf("Game %u: %d more letters\n", game, cell_count);
+  else if(record_type == DELTA_RECORD_GAME_END)
+    printf("Game %u: Finished, %u:%u\n", game, player1_points,
+           player2_points);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function watchDeltaStream, we follow a delta stream and print
+/// every record until the writer finished it. Each record is copied out of
+/// the ring before it is printed and dropped if the writer overwrote it in
+/// the meantime.
+///
+/// @param stream_name name of the stream file.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be opened.
+/// @return INVALID_CONFIG_FILE if the file is no delta stream.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int watchDeltaStream(const char* stream_name)
+{
+  DeltaStream delta_stream;
+  int return_value = openDeltaStream(stream_name, &delta_stream);
+  if(return_value == CANNOT_OPEN_CONFIG_FILE)
+    printf("Error: Cannot open file: %s\n", stream_name);
+  if(return_value == INVALID_CONFIG_FILE)
+    printf("Error: Invalid file: %s\n", stream_name);
+  if(return_value != SUCCESS)
+    return return_value;
+  unsigned char* record_copy =
+      (unsigned char*)malloc(delta_stream.ring_size_ / 8);
+  if(record_copy == NULL)
+  {
+    closeDeltaStream(&delta_stream);
+    printf("Error: Out of memory\n");
+    return OUT_MEMORY_ERROR;
+  }
+
+  DeltaSubscriber delta_subscriber;
+  subscribeDeltaStream(&delta_stream, &delta_subscriber);
+  while(1)
+  {
+    // the finished flag is read first, so no record written before it is
+    // missed
+    int finished = atomic_load_explicit(&delta_stream.header_->finished_,
+                                        memory_order_acquire);
+    const unsigned char* record = NULL;
+    int record_size = 0;
+    int record_type = readDeltaRecord(&delta_stream, &delta_subscriber,
+                                      &record, &record_size);
+    if(record_type == DELTA_RECORD_NONE)
+    {
+      if(finished)
+        break;
+      usleep(DELTA_WATCH_POLL_MICROSECONDS);
+      continue;
+    }
+    if((unsigned long long)record_size > delta_stream.ring_size_ / 8)
+      continue;
+    memcpy(record_copy, record, record_size);
+    if(deltaRecordOverwritten(&delta_stream, &delta_subscriber))
+      continue;
+    printDeltaRecord(record_copy, record_type);
+    fflush(stdout);
+  }
+  free(record_copy);
+  closeDeltaStream(&delta_stream);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function initializeGameState, we set up the field, the letter
+/// table and the save writer of a new game.
+///
+/// @param game_state the state to set up.
+/// @param file_elements_array which holds the file in a string format.
+/// @param char_points_string used to get the amount of points per each input.
+/// @param player1_points holds the value of the points for player 1.
+/// @param player2_points holds the value of the points for player 2.
+/// @param field_size holds the size of the field.
+/// @param player_turn shows whos turn it is.
+/// @param config_name name of config file.
+/// @param shared_dictionary dictionary to use without a copy, NULL to load
+///                          one for this game.
+///
+/// @return OUT_MEMORY_ERROR in case of problems.
+/// @return SUCCESS otherwise.
+//
+int initializeGameState(GameState* game_state, char** file_elements_array,
+                        char* char_points_string, int player1_points,
+                        int player2_points, int field_size, int player_turn,
+                        char* config_name,
+                        const Dictionary* shared_dictionary)
+{
+  getBoardKernels(field_size, &game_state->board_kernels_);
+  game_state->game_play_field_ = initializeGameField(
+      file_elements_array, char_points_string, &game_state->board_kernels_);
+  if(game_state->game_play_field_ == NULL)
+    return OUT_MEMORY_ERROR;
+  buildLetterTable(char_points_string, &game_state->letter_table_);
+  game_state->char_points_string_ = char_points_string;
+  game_state->config_name_ = config_name;
+  game_state->player1_points_ = player1_points;
+  game_state->player2_points_ = player2_points;
+  game_state->player_turn_ = player_turn;
+  game_state->winning_points_ = (field_size * field_size) / 2;
+  memset(game_state->racks_, 0, sizeof(game_state->racks_));
+  memset(&game_state->hint_cache_, 0, sizeof(HintCache));
+  game_state->delta_stream_ = NULL;
+  memset(&game_state->delta_game_, 0, sizeof(DeltaGame));
+  initializeSaveWriter(&game_state->save_writer_);
+  // the book and the dictionary are optional, without them every lookup
+  // misses
+  openOpeningBook(OPENING_BOOK_NAME, &game_state->opening_book_);
+  game_state->dictionary_shared_ = (shared_dictionary != NULL);
+  if(game_state->dictionary_shared_)
+    game_state->dictionary_ = *shared_dictionary;
+  else
+    loadDictionary(DICTIONARY_NAME, &game_state->dictionary_);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function freeGameState, we wait for the last save and free
+/// everything of a game. A published game ends in its delta stream.
+///
+/// @param game_state the state to free.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if a save could not be written.
+/// @return SUCCESS otherwise.
+//
+int freeGameState(GameState* game_state)
+{
+  int return_value = stopSaveWriter(&game_state->save_writer_);
+  if(game_state->delta_stream_ != NULL)
+    publishGameEndDelta(game_state->delta_stream_, &game_state->delta_game_,
+                        game_state->player1_points_,
+                        game_state->player2_points_);
+  closeOpeningBook(&game_state->opening_book_);
+  if(!game_state->dictionary_shared_)
+    freeDictionary(&game_state->dictionary_);
+  freeHintCache(&game_state->hint_cache_);
+  free(game_state->char_points_string_);
+  const BoardKernels* board_kernels = &game_state->board_kernels_;
+  board_kernels->free_field_(game_state->game_play_field_,
+                             board_kernels->field_size_);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function publishGameState, we let a game publish its moves to a
+/// delta stream, starting with a snapshot of its field.
+///
+/// @param game_state the running game.
+/// @param delta_stream the stream, it has to stay open until the game is
+///                     freed.
+/// @param game the number of the game in the stream.
+///
+/// @return
+//
+void publishGameState(GameState* game_state, DeltaStream* delta_stream,
+                      unsigned int game)
+{
+  game_state->delta_stream_ = delta_stream;
+  game_state->delta_game_.game_ = game;
+  publishSnapshotDelta(delta_stream, &game_state->delta_game_,
+                       game_state->game_play_field_,
+                       &game_state->board_kernels_,
+                       game_state->player1_points_,
+                       game_state->player2_points_,
+                       game_state->player_turn_);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameStateInsertWord, we insert a word for the player to
+/// move, add the points and pass the turn on. The move is published if the
+/// game has a delta stream.
+///
+/// @param game_state the running game.
+/// @param row first row of the word, counted from 0.
+/// @param column first column of the word, counted from 0.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param word the letters in lower case.
+/// @param word_size the number of letters in the word.
+/// @param points_won receives the points of the move.
+///
+/// @return return_value of fieldInsertWord.
+//
+int gameStateInsertWord(GameState* game_state, int row, int column,
+                        int orientation, const char* word, int word_size,
+                        int* points_won)
+{
+  int player_1 = 1;
+  int player_2 = 2;
+  char eos = '\0';
+  // a player with a rack has to take the letters of the free cells from it
+  char* rack = game_state->racks_[game_state->player_turn_ - 1];
+  char rack_left[RACK_MAX_SIZE + 1];
+  if(rack[0] != eos)
+  {
+    int rack_value = rackLettersCheck(game_state, row, column, orientation,
+                                      word, word_size, rack_left);
+    if(rack_value != SUCCESS)
+      return rack_value;
+  }
+  int return_value = fieldInsertWord(game_state->game_play_field_,
+                                     &game_state->board_kernels_, row, column,
+                                     orientation, word, word_size,
+                                     &game_state->letter_table_, points_won);
+  if(return_value != SUCCESS)
+    return return_value;
+  if(rack[0] != eos)
+    strcpy(rack, rack_left);
+  touchHintCache(&game_state->hint_cache_,
+                 game_state->board_kernels_.field_size_, row, column,
+                 orientation, word_size);
+
+  if(game_state->player_turn_ == player_1)
+    game_state->player1_points_ += *points_won;
+  else
+    game_state->player2_points_ += *points_won;
+  if(game_state->delta_stream_ != NULL)
+    publishMoveDelta(game_state->delta_stream_, &game_state->delta_game_,
+                     game_state->game_play_field_,
+                     &game_state->board_kernels_, row, column, orientation,
+                     word_size, game_state->player1_points_,
+                     game_state->player2_points_, game_state->player_turn_);
+  if(game_state->player_turn_ != player_1)
+    game_state->player_turn_ = player_1;
+  else
+    game_state->player_turn_ = player_2;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameStateSave, we hand a snapshot of the game to the
+/// save writer.
+///
+/// @param game_state the running game.
+///
+/// @return OUT_MEMORY_ERROR if the snapshot could not be allocated.
+/// @return return_value of submitSaveSnapshot otherwise.
+//
+int gameStateSave(GameState* game_state)
+{
+  SaveSnapshot* save_snapshot = createSaveSnapshot(
+      game_state->game_play_field_, &game_state->board_kernels_,
+      game_state->char_points_string_, game_state->config_name_,
+      game_state->player1_points_, game_state->player2_points_,
+      game_state->player_turn_);
+  if(save_snapshot == NULL)
+    return OUT_MEMORY_ERROR;
+  return submitSaveSnapshot(&game_state->save_writer_, save_snapshot);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameStateWinner, we check if a player reached the
+/// winning points.
+///
+/// @param game_state the running game.
+///
+/// @return 0 if nobody won yet.
+/// @return player the number of the player who won.
+//
+int gameStateWinner(const GameState* game_state)
+{
+  int player_1 = 1;
+  int player_2 = 2;
+  if(game_state->player1_points_ >= game_state->winning_points_)
+    return player_1;
+  if(game_state->player2_points_ >= game_state->winning_points_)
+    return player_2;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gamePlayBinarySession, we answer binary frames until the
+/// game is won, a player quits or the input ends. Frames are read into one
+/// buffer on the stack and decoded in place. A frame which is too big is
+/// skipped and answered with invalid parameters.
+///
+/// @param game_state the running game.
+/// @param input where the frames come from.
+/// @param output where the responses go to.
+///
+/// @return OUT_MEMORY_ERROR if an insert or save ran out of memory.
+/// @return SUCCESS otherwise.
+//
+int gamePlayBinarySession(GameState* game_state, FILE* input, FILE* output)
+{
+  char eos = '\0';
+  int error_invalid_param = 2;
+  unsigned char frame[BINARY_FRAME_SIZE + 1];
+
+  // the answer to the text command, everything after it is binary
+  writeBinaryResponse(game_state, output, BINARY_NONE, SUCCESS, NULL, 0, 0);
+  fflush(output);
+  while(1)
+  {
+    unsigned char length_field[BINARY_LENGTH_SIZE];
+    if(fread(length_field, 1, BINARY_LENGTH_SIZE, input) != BINARY_LENGTH_SIZE)
+      return SUCCESS;
+    unsigned int frame_size = getDeltaValue(length_field, BINARY_LENGTH_SIZE);
+    if((frame_size == 0) || (frame_size > BINARY_FRAME_SIZE))
+    {
+      while(frame_size > 0)
+      {
+        unsigned int skip_size = frame_size;
+        if(skip_size > BINARY_FRAME_SIZE)
+          skip_size = BINARY_FRAME_SIZE;
+        if(fread(frame, 1, skip_size, input) != skip_size)
+          return SUCCESS;
+        frame_size -= skip_size;
+      }
+      writeBinaryResponse(game_state, output, BINARY_NONE,
+                          error_invalid_param, NULL, 0, 0);
+      fflush(output);
+      continue;
+    }
+    if(fread(frame, 1, frame_size, input) != frame_size)
+      return SUCCESS;
+
+    int command = frame[0];
+    unsigned char* payload = frame + 1;
+    int payload_size = (int)frame_size - 1;
+    int return_value = SUCCESS;
+    if(command == BINARY_INSERT)
+    {
+      int points_won = 0;
+      if(payload_size < BINARY_INSERT_HEADER_SIZE)
+        return_value = error_invalid_param;
+      else
+      {
+        char* word = (char*)payload + BINARY_INSERT_HEADER_SIZE;
+        int word_size = payload_size - BINARY_INSERT_HEADER_SIZE;
+        int word_iterator = 0;
+        for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+          word[word_iterator] = (char)tolower(word[word_iterator]);
+        word[word_size] = eos;
+        return_value = gameStateInsertWord(
+            game_state, (int)getDeltaValue(payload, 2),
+            (int)getDeltaValue(payload + 2, 2), payload[4], word, word_size,
+            &points_won);
+      }
+      unsigned char points_field[4];
+      putDeltaValue(points_field, (unsigned int)points_won, 4);
+      writeBinaryResponse(game_state, output, command, return_value,
+                          points_field, 4, 0);
+      if(gameStateWinner(game_state))
+        return SUCCESS;
+    }
+    else if(command == BINARY_SAVE)
+    {
+      // a background save which failed is reported with the next save
+      return_value = takeSaveWriterError(&game_state->save_writer_);
+      if(return_value == SUCCESS)
+        return_value = gameStateSave(game_state);
+      writeBinaryResponse(game_state, output, command, return_value, NULL, 0,
+                          0);
+    }
+    else if(command == BINARY_QUERY_BOARD)
+      writeBinaryBoard(game_state, output);
+    else if(command == BINARY_QUERY_SCORES)
+      writeBinaryResponse(game_state, output, command, SUCCESS, NULL, 0, 0);
+    else if(command == BINARY_QUIT)
+    {
+      writeBinaryResponse(game_state, output, command, SUCCESS, NULL, 0, 0);
+      fflush(output);
+      return SUCCESS;
+    }
+    else
+      writeBinaryResponse(game_state, output, command, return_value, NULL, 0,
+                          0);
+    fflush(output);
+    if(return_value == OUT_MEMORY_ERROR)
+      return OUT_MEMORY_ERROR;
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function binaryStatus, we turn the return value of a binary
+/// command into the status of its response. The return values of the
+/// commands overlap, the statuses do not.
+///
+/// @param command the command which is answered.
+/// @param result SUCCESS or the error of the command.
+///
+/// @return status one of the BINARY_STATUS_ numbers.
+//
+int binaryStatus(int command, int result)
+{
+  int error_invalid_param = 2;
+  if((command < BINARY_NONE) || (command > BINARY_QUIT))
+    return BINARY_STATUS_UNKNOWN;
+  if(result == SUCCESS)
+    return BINARY_STATUS_OK;
+  if(result == OUT_MEMORY_ERROR)
+    return BINARY_STATUS_NO_MEMORY;
+  if(command == BINARY_SAVE)
+    return BINARY_STATUS_SAVE_FAILED;
+  if(result == error_invalid_param)
+    return BINARY_STATUS_INVALID;
+  return BINARY_STATUS_IMPOSSIBLE;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function writeBinaryResponse, we write the header of a response
+/// with the scores and the payload after it.
+///
+/// @param game_state the running game.
+/// @param output where the response goes to.
+/// @param command the command which is answered.
+/// @param result SUCCESS or the error of the command, see binaryStatus.
+/// @param payload the bytes after the header, may be NULL.
+/// @param payload_size the number of bytes in payload.
+/// @param trailing_size the number of bytes the caller writes afterwards.
+///
+/// @return
+//
+void writeBinaryResponse(const GameState* game_state, FILE* output,
+                         int command, int result,
+                         const unsigned char* payload, int payload_size,
+                         int trailing_size)
+{
+  unsigned char header[BINARY_RESPONSE_HEADER_SIZE];
+  int response_size = BINARY_RESPONSE_HEADER_SIZE - BINARY_LENGTH_SIZE +
+                      payload_size + trailing_size;
+  putDeltaValue(header, (unsigned int)response_size, BINARY_LENGTH_SIZE);
+  header[4] = (unsigned char)command;
+  header[5] = (unsigned char)binaryStatus(command, result);
+  header[6] = (unsigned char)game_state->player_turn_;
+  header[7] = (unsigned char)gameStateWinner(game_state);
+  putDeltaValue(header + 8, (unsigned int)game_state->player1_points_, 4);
+  putDeltaValue(header + 12, (unsigned int)game_state->player2_points_, 4);
+  fwrite(header, 1, BINARY_RESPONSE_HEADER_SIZE, output);
+  if(payload_size > 0)
+    fwrite(payload, 1, (size_t)payload_size, output);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function writeBinaryBoard, we answer BINARY_QUERY_BOARD with every
+/// letter on the field, in the cell layout of the delta records. The
+/// letters are counted first and then written straight to the output.
+///
+/// @param game_state the running game.
+/// @param output where the response goes to.
+///
+/// @return
+//
+void writeBinaryBoard(const GameState* game_state, FILE* output)
+{
+  char space = ' ';
+  int allocate_cell = 0;
+  const BoardKernels* board_kernels = &game_state->board_kernels_;
+  int field_size = board_kernels->field_size_;
+  int chunks_per_line = (field_size + FIELD_CHUNK_SIZE - 1) / FIELD_CHUNK_SIZE;
+  int chunk_count = chunks_per_line * chunks_per_line;
+
+  int cell_count = 0;
+  int counting = 0;
+  for(counting = 1; counting >= 0; counting--)
+  {
+    if(!counting)
+    {
+      unsigned char board_header[BINARY_BOARD_HEADER_SIZE];
+      putDeltaValue(board_header, (unsigned int)field_size, 2);
+      putDeltaValue(board_header + 2, (unsigned int)cell_count, 4);
+      writeBinaryResponse(game_state, output, BINARY_QUERY_BOARD, SUCCESS,
+                          board_header, BINARY_BOARD_HEADER_SIZE,
+                          cell_count * DELTA_CELL_SIZE);
+    }
+    int chunk_iterator = 0;
+    for(chunk_iterator = 0; chunk_iterator < chunk_count; chunk_iterator++)
+    {
+      int first_row = (chunk_iterator / chunks_per_line) * FIELD_CHUNK_SIZE;
+      int first_column = (chunk_iterator % chunks_per_line) * FIELD_CHUNK_SIZE;
+      if(board_kernels->cell_(game_state->game_play_field_, field_size,
+                              first_row, first_column, allocate_cell) == NULL)
+        continue;
+      int cell_iterator = 0;
+      for(cell_iterator = 0; cell_iterator < FIELD_CHUNK_CELLS;
+          cell_iterator++)
+      {
+        int cell_row = first_row + cell_iterator / FIELD_CHUNK_SIZE;
+        int cell_column = first_column + cell_iterator % FIELD_CHUNK_SIZE;
+        if((cell_row >= field_size) || (cell_column >= field_size))
+          continue;
+        char field_char = fieldLetter(game_state->game_play_field_,
+                                      board_kernels, cell_row, cell_column);
+        if(field_char == space)
+          continue;
+        if(counting)
+        {
+          cell_count++;
+          continue;
+        }
+        unsigned char board_cell[DELTA_CELL_SIZE];
+        putDeltaValue(board_cell, (unsigned int)cell_row, 2);
+        putDeltaValue(board_cell + 2, (unsigned int)cell_column, 2);
+        board_cell[4] = (unsigned char)field_char;
+        fwrite(board_cell, 1, DELTA_CELL_SIZE, output);
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function loadGameState, we read a config file and set up the game
+/// of it. Problems are printed like in the main function.
+///
+/// @param config_name name of config file.
+/// @param game_state the state to set up.
+/// @param shared_dictionary dictionary to use without a copy, NULL to load
+///                          one for this game.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be opened.
+/// @return INVALID_CONFIG_FILE if the file is not a valid config.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int loadGameState(char* config_name, GameState* game_state,
+                  const Dictionary* shared_dictionary)
+{
+  FILE* config_text = fopen(config_name, "r");
+  if(config_text == NULL)
+  {
+    printf("Error: Cannot open file: %s\n", config_name);
+    return CANNOT_OPEN_CONFIG_FILE;
+  }
+
+  char* char_points_string = NULL;
+  int player1_points = 0;
+  int player2_points = 0;
+  int field_size = 0;
+  int player_turn = 0;
+  int return_value = 0;
+  char** file_elements_array = getConfigContent(config_text, &return_value,
+                                                &char_points_string,
+                                                &player1_points,
+                                                &player2_points,
+                                                &field_size,
+                                                &player_turn);
+  if(file_elements_array == NULL)
+  {
+    if(return_value == INVALID_CONFIG_FILE)
+      printf("Error: Invalid file: %s\n", config_name);
+    else
+      printf("Error: Out of memory\n");
+    return return_value;
+  }
+
+  return_value = initializeGameState(game_state, file_elements_array,
+                                     char_points_string, player1_points,
+                                     player2_points, field_size, player_turn,
+                                     config_name, shared_dictionary);
+  if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function runToolCommand, we run one of the tools which are called
+/// with an option starting with "--" instead of a config file.
+///
+/// @param argc the number of arguments.
+/// @param argv the arguments.
+///
+/// @return WRONG_ARGUMENTS_NR if the tool or its arguments are unknown.
+/// @return return_value of the tool otherwise.
+//
+int runToolCommand(int argc, char** argv)
+{
+  int tool_id = 1;
+  int config_id = 2;
+  int count_id = 3;
+  if(strcmp(argv[tool_id], "--benchmark-packing") == 0)
+  {
+    if(argc == count_id)
+      return runPackingBenchmark(argv[config_id], PACKED_BENCHMARK_POSITIONS);
+    if((argc == count_id + 1) && (atoi(argv[count_id]) > 0))
+      return runPackingBenchmark(argv[config_id], atoi(argv[count_id]));
+  }
+  if((strcmp(argv[tool_id], "--build-book") == 0) && (argc > count_id + 1))
+    return buildOpeningBook(argv[config_id], argv[count_id],
+                            argv + count_id + 1, argc - count_id - 1);
+  if((strcmp(argv[tool_id], "--tournament") == 0) && (argc > count_id + 1))
+    return runTournament(argv[config_id], argv[count_id],
+                         argv + count_id + 1, argc - count_id - 1);
+  if((strcmp(argv[tool_id], "--read-archive") == 0) && (argc == count_id))
+    return readArchive(argv[config_id], NULL);
+  if((strcmp(argv[tool_id], "--read-archive") == 0) &&
+     (argc == count_id + 1))
+    return readArchive(argv[config_id], argv[count_id]);
+  if(strcmp(argv[tool_id], "--evaluate") == 0)
+  {
+    int candidate_count = MONTE_CARLO_CANDIDATES;
+    int simulations = MONTE_CARLO_SIMULATIONS;
+    if(argc > count_id)
+      candidate_count = atoi(argv[count_id]);
+    if(argc > count_id + 1)
+      simulations = atoi(argv[count_id + 1]);
+    if((argc >= count_id) && (argc <= count_id + 2) &&
+       (candidate_count > 0) &&
+       (candidate_count <= MONTE_CARLO_MAX_CANDIDATES) && (simulations > 0))
+      return evaluateMoves(argv[config_id], candidate_count, simulations);
+  }
+  if((strcmp(argv[tool_id], "--analyze") == 0) && (argc >= count_id))
+    return analyzeCorpus(argv + config_id, argc - config_id);
+  if((strcmp(argv[tool_id], "--build-image") == 0) && (argc == count_id))
+    return buildDictionaryImage(argv[config_id]);
+  if((strcmp(argv[tool_id], "--publish") == 0) && (argc == count_id + 1))
+    return playGame(argv[config_id], argv[count_id]);
+  if((strcmp(argv[tool_id], "--watch") == 0) && (argc == count_id))
+    return watchDeltaStream(argv[config_id]);
+  if(strcmp(argv[tool_id], "--serve") == 0)
+  {
+    if(argc == count_id + 1)
+      return runSessionServer(argv[config_id], argv[count_id], 0);
+    if((argc == count_id + 2) && (atoi(argv[count_id + 1]) > 0))
+      return runSessionServer(argv[config_id], argv[count_id],
+                              atoi(argv[count_id + 1]));
+  }
+  printf("Usage: ./a3 configfile\n"
+         "       ./a3 --benchmark-packing configfile [positions]\n"
+         "       ./a3 --build-book bookfile wordlist configfile...\n"
+         "       ./a3 --build-image wordlist\n"
+         "       ./a3 --tournament resultfile players configfile...\n"
+         "       ./a3 --publish configfile streamfile\n"
+         "       ./a3 --watch streamfile\n"
+         "       ./a3 --read-archive archivefile [column]\n"
+         "       ./a3 --analyze file...\n"
+         "       ./a3 --evaluate configfile [candidates [simulations]]\n"
+         "       ./a3 --serve port configfile [sessions]\n");
+  return WRONG_ARGUMENTS_NR;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function packedPositionMaxSize, we get the size of a packed
+/// position with every cell of the field occupied.
+///
+/// @param field_size the size of the field.
+///
+/// @return max_size the number of bytes.
+//
+int packedPositionMaxSize(int field_size)
+{
+  int byte_bits = 8;
+  int cell_count = field_size * field_size;
+  return PACKED_HEADER_SIZE + (cell_count + byte_bits - 1) / byte_bits +
+         (cell_count * PACKED_LETTER_BITS + byte_bits - 1) / byte_bits;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function encodePackedPosition, we pack the letters of the field
+/// and the game state. The field is read one row segment at a time.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param player1_points holds the value of the points for player 1.
+/// @param player2_points holds the value of the points for player 2.
+/// @param player_turn the player who moves next.
+/// @param packed receives the position, packedPositionMaxSize bytes.
+/// @param packed_size receives the number of bytes used.
+///
+/// @return error_return_value if a cell holds something else than a letter.
+/// @return SUCCESS otherwise.
+//
+int encodePackedPosition(Word** game_play_field,
+                         const BoardKernels* board_kernels,
+                         int player1_points, int player2_points,
+                         int player_turn, unsigned char* packed,
+                         int* packed_size)
+{
+  char space = ' ';
+  char first_letter = 'a';
+  int error_return_value = 1;
+  int byte_bits = 8;
+  int field_size = board_kernels->field_size_;
+  int mask_size = (field_size * field_size + byte_bits - 1) / byte_bits;
+  unsigned char* occupancy_mask = packed + PACKED_HEADER_SIZE;
+  unsigned char* packed_letter = occupancy_mask + mask_size;
+  memset(occupancy_mask, 0, mask_size);
+
+  char segment[FIELD_SEGMENT_BUFFER];
+  unsigned int bit_buffer = 0;
+  int buffered_bits = 0;
+  int letter_count = 0;
+  int row_iterator = 0;
+  for(row_iterator = 0; row_iterator < field_size; row_iterator++)
+  {
+    board_kernels->load_segment_(game_play_field, field_size, row_iterator, 0,
+                                 0, field_size, segment);
+    int column_iterator = 0;
+    for(column_iterator = 0; column_iterator < field_size; column_iterator++)
+    {
+      if(segment[column_iterator] == space)
+        continue;
+      int letter_index = segment[column_iterator] - first_letter;
+      if((letter_index < 0) || (letter_index >= ALPHABET_SIZE))
+        return error_return_value;
+      int cell_index = row_iterator * field_size + column_iterator;
+      occupancy_mask[cell_index / byte_bits] |=
+          (unsigned char)(1 << (cell_index % byte_bits));
+      bit_buffer |= (unsigned int)letter_index << buffered_bits;
+      buffered_bits += PACKED_LETTER_BITS;
+      if(buffered_bits >= byte_bits)
+      {
+        *packed_letter++ = (unsigned char)bit_buffer;
+        bit_buffer >>= byte_bits;
+        buffered_bits -= byte_bits;
+      }
+      letter_count++;
+    }
+  }
+  if(buffered_bits > 0)
+    *packed_letter++ = (unsigned char)bit_buffer;
+
+  putDeltaValue(packed, (unsigned int)player1_points, 4);
+  putDeltaValue(packed + 4, (unsigned int)player2_points, 4);
+  packed[8] = (unsigned char)player_turn;
+  putDeltaValue(packed + 9, (unsigned int)letter_count, 4);
+  *packed_size = (int)(packed_letter - packed);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function decodePackedPosition, we set the field to a packed
+/// position. Only cells which differ from the field are written, so
+/// decoding a position close to the current one is cheap.
+///
+/// @param packed the position.
+/// @param packed_size the number of bytes of the position.
+/// @param game_play_field the field to set, same size as the position.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table points of the letters.
+/// @param player1_points receives the points of player 1.
+/// @param player2_points receives the points of player 2.
+/// @param player_turn receives the player who moves next.
+///
+/// @return error_return_value if the position does not fit the field.
+/// @return OUT_MEMORY_ERROR if a chunk could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int decodePackedPosition(const unsigned char* packed, int packed_size,
+                         Word** game_play_field,
+                         const BoardKernels* board_kernels,
+                         const LetterTable* letter_table,
+                         int* player1_points, int* player2_points,
+                         int* player_turn)
+{
+  char space = ' ';
+  char first_letter = 'a';
+  int upper_case_bit = 32;
+  int error_return_value = 1;
+  int byte_bits = 8;
+  unsigned int letter_bits_mask = (1u << PACKED_LETTER_BITS) - 1;
+  int field_size = board_kernels->field_size_;
+  int mask_size = (field_size * field_size + byte_bits - 1) / byte_bits;
+  if(packed_size < PACKED_HEADER_SIZE + mask_size)
+    return error_return_value;
+  int letter_count = (int)getDeltaValue(packed + 9, 4);
+  if((letter_count > field_size * field_size) ||
+     (packed_size != PACKED_HEADER_SIZE + mask_size +
+                     (letter_count * PACKED_LETTER_BITS + byte_bits - 1) /
+                     byte_bits))
+    return error_return_value;
+
+  const unsigned char* occupancy_mask = packed + PACKED_HEADER_SIZE;
+  const unsigned char* packed_letter = occupancy_mask + mask_size;
+  char segment[FIELD_SEGMENT_BUFFER];
+  unsigned int bit_buffer = 0;
+  int buffered_bits = 0;
+  int letters_read = 0;
+  int row_iterator = 0;
+  for(row_iterator = 0; row_iterator < field_size; row_iterator++)
+  {
+    board_kernels->load_segment_(game_play_field, field_size, row_iterator, 0,
+                                 0, field_size, segment);
+    int column_iterator = 0;
+    for(column_iterator = 0; column_iterator < field_size; column_iterator++)
+    {
+      int cell_index = row_iterator * field_size + column_iterator;
+      char cell_char = space;
+      if(occupancy_mask[cell_index / byte_bits] &
+         (1 << (cell_index % byte_bits)))
+      {
+        if(letters_read == letter_count)
+          return error_return_value;
+        if(buffered_bits < PACKED_LETTER_BITS)
+        {
+          bit_buffer |= (unsigned int)*packed_letter++ << buffered_bits;
+          buffered_bits += byte_bits;
+        }
+        int letter_index = (int)(bit_buffer & letter_bits_mask);
+        bit_buffer >>= PACKED_LETTER_BITS;
+        buffered_bits -= PACKED_LETTER_BITS;
+        letters_read++;
+        if(letter_index >= ALPHABET_SIZE)
+          return error_return_value;
+        cell_char = (char)(first_letter + letter_index);
+      }
+      if(segment[column_iterator] == cell_char)
+        continue;
+
+      int allocate_cell = (cell_char != space);
+      Word* field_cell = board_kernels->cell_(game_play_field, field_size,
+                                              row_iterator, column_iterator,
+                                              allocate_cell);
+      if(field_cell == NULL)
+      {
+        if(allocate_cell)
+          return OUT_MEMORY_ERROR;
+        continue;
+      }
+      if(allocate_cell)
+      {
+        field_cell->letter_ = (char)(cell_char & ~upper_case_bit);
+        field_cell->letter_points_ =
+            letter_table->points_[cell_char - first_letter];
+      }
+      else
+      {
+        field_cell->letter_ = space;
+        field_cell->letter_points_ = 0;
+      }
+    }
+  }
+  if(letters_read != letter_count)
+    return error_return_value;
+
+  *player1_points = (int)getDeltaValue(packed, 4);
+  *player2_points = (int)getDeltaValue(packed + 4, 4);
+  *player_turn = packed[8];
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function hashPackedPosition, we hash a packed position (FNV-1a),
+/// equal positions of the same field size get the same hash.
+///
+/// @param packed the position.
+/// @param packed_size the number of bytes of the position.
+///
+/// @return hash the hash of the position.
+//
+unsigned long long hashPackedPosition(const unsigned char* packed,
+                                      int packed_size)
+{
+  unsigned long long hash = 14695981039346656037ULL;
+  unsigned long long hash_prime = 1099511628211ULL;
+  int byte_iterator = 0;
+  for(byte_iterator = 0; byte_iterator < packed_size; byte_iterator++)
+  {
+    hash ^= packed[byte_iterator];
+    hash *= hash_prime;
+  }
+  return hash;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function benchmarkSeconds, we get a monotonic time for
+/// measuring the tools.
+///
+/// @return seconds since an unspecified start.
+//
+double benchmarkSeconds(void)
+{
+  struct timespec time_now;
+  clock_gettime(CLOCK_MONOTONIC, &time_now);
+  return (double)time_now.tv_sec + (double)time_now.tv_nsec / 1e9;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function runPackingBenchmark, we measure how fast the position of
+/// a config file is packed and unpacked. All packed positions are kept in
+/// one array, like a position set used for analysis. Decoding alternates
+/// between the config position and an empty field, so every decode changes
+/// every letter.
+///
+/// @param config_name name of config file.
+/// @param position_count how many positions are packed.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return INVALID_CONFIG_FILE if the field cannot be packed.
+/// @return return_value of loadGameState otherwise.
+//
+int runPackingBenchmark(char* config_name, int position_count)
+{
+  GameState game_state;
+  int return_value = loadGameState(config_name, &game_state, NULL);
+  if(return_value != SUCCESS)
+    return return_value;
+
+  const BoardKernels* board_kernels = &game_state.board_kernels_;
+  int field_size = board_kernels->field_size_;
+  int max_size = packedPositionMaxSize(field_size);
+  int empty_size = 0;
+  int position_size = 0;
+  unsigned char* packed_positions = NULL;
+  unsigned char* empty_position = (unsigned char*)malloc(max_size);
+  Word** empty_field = board_kernels->create_field_(field_size);
+  if((empty_position == NULL) || (empty_field == NULL))
+    return_value = OUT_MEMORY_ERROR;
+  else if(encodePackedPosition(game_state.game_play_field_, board_kernels, 0,
+                               0, 1, empty_position, &position_size) !=
+          SUCCESS)
+  {
+    printf("Error: Field cannot be packed: %s\n", config_name);
+    return_value = INVALID_CONFIG_FILE;
+  }
+  else
+  {
+    // every position of the set has the letters of the config
+    encodePackedPosition(empty_field, board_kernels, 0, 0, 1, empty_position,
+                         &empty_size);
+    packed_positions =
+        (unsigned char*)malloc((size_t)position_size * position_count);
+    if(packed_positions == NULL)
+      return_value = OUT_MEMORY_ERROR;
+  }
+  if(empty_field != NULL)
+    board_kernels->free_field_(empty_field, field_size);
+
+  // the positions are stored back to back, each with its own scores
+  double encode_seconds = benchmarkSeconds();
+  long long packed_bytes = 0;
+  int position_iterator = 0;
+  for(position_iterator = 0;
+      (return_value == SUCCESS) && (position_iterator < position_count);
+      position_iterator++)
+  {
+    encodePackedPosition(game_state.game_play_field_, board_kernels,
+                         game_state.player1_points_ + position_iterator,
+                         game_state.player2_points_, game_state.player_turn_,
+                         packed_positions + packed_bytes, &position_size);
+    packed_bytes += position_size;
+  }
+  encode_seconds = benchmarkSeconds() - encode_seconds;
+
+  // hashing the set shows how cheap deduplication by hash is
+  double hash_seconds = benchmarkSeconds();
+  unsigned long long hash_sum = 0;
+  for(position_iterator = 0;
+      (return_value == SUCCESS) && (position_iterator < position_count);
+      position_iterator++)
+    hash_sum += hashPackedPosition(
+        packed_positions + (long long)position_iterator * position_size,
+        position_size);
+  hash_seconds = benchmarkSeconds() - hash_seconds;
+
+  double decode_seconds = benchmarkSeconds();
+  int player1_points = 0;
+  int player2_points = 0;
+  int player_turn = 0;
+  for(position_iterator = 0;
+      (return_value == SUCCESS) && (position_iterator < position_count);
+      position_iterator++)
+  {
+    const unsigned char* packed = empty_position;
+    int packed_size = empty_size;
+    if(position_iterator % 2)
+    {
+      packed = packed_positions + (long long)position_iterator * position_size;
+      packed_size = position_size;
+    }
+    return_value = decodePackedPosition(packed, packed_size,
+                                        game_state.game_play_field_,
+                                        board_kernels,
+                                        &game_state.letter_table_,
+                                        &player1_points, &player2_points,
+                                        &player_turn);
+    if((return_value != SUCCESS) && (return_value != OUT_MEMORY_ERROR))
+      return_value = INVALID_CONFIG_FILE;
+  }
+  decode_seconds = benchmarkSeconds() - decode_seconds;
+
+  if(return_value == SUCCESS)
+  {
+    long long field_bytes = (long long)field_size * field_size * sizeof(Word) +
+                            (long long)field_size * sizeof(Word*);
+    printf("Field %dx%d: %lld bytes as Word cells, %d bytes packed\n",
+           field_size, field_size, field_bytes, position_size);
+    printf("%d positions: %lld bytes packed\n", position_count, packed_bytes);
+    printf("Encode: %.3f s, %.0f positions/s\n", encode_seconds,
+           position_count / encode_seconds);
+    printf("Hash: %.3f s, %.0f positions/s (%016llx)\n", hash_seconds,
+           position_count / hash_seconds, hash_sum);
+    printf("Decode: %.3f s, %.0f positions/s\n", decode_seconds,
+           position_count / decode_seconds);
+  }
+  else if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+  free(empty_position);
+  free(packed_positions);
+  freeGameState(&game_state);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function loadWordList, we read a word list file with one word per
+/// line. Words are lowercased, lines with other characters than letters are
+/// skipped.
+///
+/// @param word_list_name name of the word list file.
+/// @param word_list receives the words.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be read.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int loadWordList(const char* word_list_name, WordList* word_list)
+{
+  char eos = '\0';
+  char new_line = '\n';
+  char carriage_return = '\r';
+  char small_a = 'a';
+  char small_z = 'z';
+  memset(word_list, 0, sizeof(WordList));
+  FILE* word_file = fopen(word_list_name, "rb");
+  if(word_file == NULL)
+    return CANNOT_OPEN_CONFIG_FILE;
+  fseek(word_file, 0, SEEK_END);
+  long file_size = ftell(word_file);
+  fseek(word_file, 0, SEEK_SET);
+  if(file_size < 0)
+  {
+    fclose(word_file);
+    return CANNOT_OPEN_CONFIG_FILE;
+  }
+
+  // every word needs at least two bytes, a letter and a line end
+  int max_words = (int)(file_size / 2 + 1);
+  word_list->words_ = (char*)malloc(file_size + 1);
+  word_list->offsets_ = (int*)malloc(max_words * sizeof(int));
+  word_list->sizes_ = (int*)malloc(max_words * sizeof(int));
+  if((word_list->words_ == NULL) || (word_list->offsets_ == NULL) ||
+     (word_list->sizes_ == NULL))
+  {
+    fclose(word_file);
+    freeWordList(word_list);
+    return OUT_MEMORY_ERROR;
+  }
+  size_t read_size = fread(word_list->words_, 1, file_size, word_file);
+  fclose(word_file);
+  if(read_size != (size_t)file_size)
+  {
+    freeWordList(word_list);
+    return CANNOT_OPEN_CONFIG_FILE;
+  }
+  word_list->words_[file_size] = new_line;
+
+  // words are moved to the front of the buffer, ending with eos
+  int write_position = 0;
+  int word_start = 0;
+  int word_valid = 1;
+  long read_position = 0;
+  for(read_position = 0; read_position <= file_size; read_position++)
+  {
+    char word_char = (char)tolower(word_list->words_[read_position]);
+    if((word_char != new_line) && (word_char != carriage_return))
+    {
+      if((word_char < small_a) || (word_char > small_z))
+        word_valid = 0;
+      word_list->words_[write_position++] = word_char;
+      continue;
+    }
+    int word_size = write_position - word_start;
+    if(word_valid && (word_size > 0))
+    {
+      word_list->words_[write_position++] = eos;
+      word_list->offsets_[word_list->count_] = word_start;
+      word_list->sizes_[word_list->count_] = word_size;
+      word_list->count_++;
+    }
+    else
+      write_position = word_start;
+    word_start = write_position;
+    word_valid = 1;
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function freeWordList, we free the words of a word list.
+///
+/// @param word_list the list to free.
+///
+/// @return
+//
+void freeWordList(WordList* word_list)
+{
+  free(word_list->words_);
+  free(word_list->offsets_);
+  free(word_list->sizes_);
+  memset(word_list, 0, sizeof(WordList));
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function searchBestMove, we try every word of the list on every
+/// row and column and keep the placement with the most points. All start
+/// offsets of a line are checked at once by segmentMatchAllOffsets, so this
+/// only works on fields up to MAX_FIELD_SIZE.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table letters and points of the game.
+/// @param word_list the words to try.
+/// @param best_move receives the best placement.
+///
+/// @return error_return_value if no word can be placed.
+/// @return SUCCESS otherwise.
+//
+int searchBestMove(Word** game_play_field, const BoardKernels* board_kernels,
+                   const LetterTable* letter_table, const WordList* word_list,
+                   FieldMove* best_move)
+{
+  char space = ' ';
+  char small_a = 'a';
+  int error_return_value = 1;
+  int orientation_count = 2;
+  int field_size = board_kernels->field_size_;
+  if(board_kernels->load_line_ == NULL)
+    return error_return_value;
+
+  char field_lines[2][MAX_FIELD_SIZE][FIELD_LINE_BUFFER];
+  int orientation = 0;
+  int line_index = 0;
+  for(orientation = 0; orientation < orientation_count; orientation++)
+    for(line_index = 0; line_index < field_size; line_index++)
+      board_kernels->load_line_(game_play_field, field_size, line_index,
+                                orientation,
+                                field_lines[orientation][line_index]);
+  int field_empty = board_kernels->check_empty_(game_play_field, field_size);
+
+  best_move->points_ = -1;
+  int word_iterator = 0;
+  for(word_iterator = 0; word_iterator < word_list->count_; word_iterator++)
+  {
+    const char* word = word_list->words_ + word_list->offsets_[word_iterator];
+    int word_size = word_list->sizes_[word_iterator];
+    if((word_size > field_size) || (word_size >= MOVE_WORD_SIZE) ||
+       (placementParameterCheck(field_size, 0, 0, 0, word, word_size,
+                                letter_table) != SUCCESS))
+      continue;
+
+    for(orientation = 0; orientation < orientation_count; orientation++)
+    {
+      for(line_index = 0; line_index < field_size; line_index++)
+      {
+        const char* field_line = field_lines[orientation][line_index];
+        unsigned int conflict_starts = 0;
+        unsigned int overlap_starts = 0;
+        unsigned int occupied_starts = 0;
+        segmentMatchAllOffsets(field_line, field_size, word, word_size,
+                               &conflict_starts, &overlap_starts,
+                               &occupied_starts);
+        unsigned int legal_starts = overlap_starts & ~conflict_starts;
+        if(field_empty)
+        {
+          int start_count = field_size - word_size + 1;
+          legal_starts = 0xFFFFFFFFu;
+          if(start_count < SEGMENT_VECTOR_SIZE)
+            legal_starts = (1u << start_count) - 1u;
+        }
+
+        while(legal_starts)
+        {
+          int start = __builtin_ctz(legal_starts);
+          legal_starts &= legal_starts - 1;
+          int points = 0;
+          int letter_iterator = 0;
+          for(letter_iterator = 0; letter_iterator < word_size;
+              letter_iterator++)
+            if(field_line[start + letter_iterator] == space)
+              points += letter_table->points_[word[letter_iterator] - small_a];
+          if(points <= best_move->points_)
+            continue;
+
+          best_move->points_ = points;
+          best_move->orientation_ = orientation;
+          best_move->row_ = line_index;
+          best_move->column_ = start;
+          if(orientation)
+          {
+            best_move->row_ = start;
+            best_move->column_ = line_index;
+          }
+          memcpy(best_move->word_, word, word_size + 1);
+        }
+      }
+    }
+  }
+  if(best_move->points_ < 0)
+    return error_return_value;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function openOpeningBook, we map an opening book read only. Only
+/// the header is checked, so opening takes the same time for every size.
+///
+/// @param book_name name of the book file.
+/// @param opening_book receives the book, empty if it cannot be opened.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be mapped.
+/// @return INVALID_CONFIG_FILE if the file is not an opening book.
+/// @return SUCCESS otherwise.
+//
+int openOpeningBook(const char* book_name, OpeningBook* opening_book)
+{
+  memset(opening_book, 0, sizeof(OpeningBook));
+  int book_file = open(book_name, O_RDONLY);
+  if(book_file < 0)
+    return CANNOT_OPEN_CONFIG_FILE;
+  struct stat book_stat;
+  if((fstat(book_file, &book_stat) != 0) ||
+     (book_stat.st_size < BOOK_HEADER_SIZE))
+  {
+    close(book_file);
+    return INVALID_CONFIG_FILE;
+  }
+  size_t map_size = (size_t)book_stat.st_size;
+  void* book_map = mmap(NULL, map_size, PROT_READ, MAP_SHARED, book_file, 0);
+  close(book_file);
+  if(book_map == MAP_FAILED)
+    return CANNOT_OPEN_CONFIG_FILE;
+
+  const unsigned char* book_header = (const unsigned char*)book_map;
+  unsigned int slot_count = getDeltaValue(book_header + BOOK_MAGIC_SIZE, 4);
+  if((memcmp(book_header, BOOK_MAGIC, BOOK_MAGIC_SIZE) != 0) ||
+     (slot_count == 0) || (slot_count & (slot_count - 1)) ||
+     (map_size != BOOK_HEADER_SIZE + (size_t)slot_count * BOOK_ENTRY_SIZE))
+  {
+    munmap(book_map, map_size);
+    return INVALID_CONFIG_FILE;
+  }
+  opening_book->map_ = book_header;
+  opening_book->map_size_ = map_size;
+  opening_book->slot_count_ = slot_count;
+  opening_book->entry_count_ = getDeltaValue(book_header + 12, 4);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function closeOpeningBook, we unmap an opening book.
+///
+/// @param opening_book the book, may be empty.
+///
+/// @return
+//
+void closeOpeningBook(OpeningBook* opening_book)
+{
+  if(opening_book->map_ != NULL)
+    munmap((void*)opening_book->map_, opening_book->map_size_);
+  memset(opening_book, 0, sizeof(OpeningBook));
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function findBookSlot, we probe the slots of a book for a
+/// position hash.
+///
+/// @param book_slots the first slot.
+/// @param slot_count the number of slots, a power of two.
+/// @param hash the position hash, not 0.
+///
+/// @return slot_index of the slot with the hash or of the free slot where
+///                    it would be.
+/// @return slot_count if every slot holds another hash.
+//
+unsigned int findBookSlot(const unsigned char* book_slots,
+                          unsigned int slot_count, unsigned long long hash)
+{
+  unsigned int slot_index = (unsigned int)hash & (slot_count - 1);
+  unsigned int probe_iterator = 0;
+  for(probe_iterator = 0; probe_iterator < slot_count; probe_iterator++)
+  {
+    const unsigned char* book_entry =
+        book_slots + (size_t)slot_index * BOOK_ENTRY_SIZE;
+    unsigned long long entry_hash =
+        (unsigned long long)getDeltaValue(book_entry + 4, 4) << 32 |
+        getDeltaValue(book_entry, 4);
+    if((entry_hash == hash) || (entry_hash == 0))
+      return slot_index;
+    slot_index = (slot_index + 1) & (slot_count - 1);
+  }
+  return slot_count;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function lookupOpeningBook, we get the move stored for a
+/// position.
+///
+/// @param opening_book the book, may be empty.
+/// @param hash the position hash, not 0.
+/// @param book_move receives the move.
+///
+/// @return error_return_value if the book has no move for the position.
+/// @return SUCCESS otherwise.
+//
+int lookupOpeningBook(const OpeningBook* opening_book,
+                      unsigned long long hash, FieldMove* book_move)
+{
+  int error_return_value = 1;
+  if(opening_book->map_ == NULL)
+    return error_return_value;
+  const unsigned char* book_slots = opening_book->map_ + BOOK_HEADER_SIZE;
+  unsigned int slot_index = findBookSlot(book_slots, opening_book->slot_count_,
+                                         hash);
+  if(slot_index == opening_book->slot_count_)
+    return error_return_value;
+  const unsigned char* book_entry =
+      book_slots + (size_t)slot_index * BOOK_ENTRY_SIZE;
+  if((getDeltaValue(book_entry, 4) | getDeltaValue(book_entry + 4, 4)) == 0)
+    return error_return_value;
+  getBookEntry(book_entry, book_move);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function putBookEntry, we encode a move into a book slot.
+///
+/// @param book_entry the slot.
+/// @param hash the position hash, not 0.
+/// @param book_move the move.
+///
+/// @return
+//
+void putBookEntry(unsigned char* book_entry, unsigned long long hash,
+                  const FieldMove* book_move)
+{
+  int word_size = (int)strlen(book_move->word_);
+  memset(book_entry, 0, BOOK_ENTRY_SIZE);
+  putDeltaValue(book_entry, (unsigned int)hash, 4);
+  putDeltaValue(book_entry + 4, (unsigned int)(hash >> 32), 4);
+  putDeltaValue(book_entry + 8, (unsigned int)book_move->row_, 2);
+  putDeltaValue(book_entry + 10, (unsigned int)book_move->column_, 2);
+  book_entry[12] = (unsigned char)book_move->orientation_;
+  book_entry[13] = (unsigned char)word_size;
+  putDeltaValue(book_entry + 14, (unsigned int)book_move->points_, 2);
+  memcpy(book_entry + BOOK_ENTRY_SIZE - BOOK_WORD_SIZE, book_move->word_,
+         word_size);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function getBookEntry, we decode the move of a book slot.
+///
+/// @param book_entry the slot.
+/// @param book_move receives the move.
+///
+/// @return
+//
+void getBookEntry(const unsigned char* book_entry, FieldMove* book_move)
+{
+  char eos = '\0';
+  int word_size = book_entry[13];
+  if(word_size >= BOOK_WORD_SIZE)
+    word_size = BOOK_WORD_SIZE - 1;
+  book_move->row_ = (int)getDeltaValue(book_entry + 8, 2);
+  book_move->column_ = (int)getDeltaValue(book_entry + 10, 2);
+  book_move->orientation_ = book_entry[12];
+  book_move->points_ = (int)getDeltaValue(book_entry + 14, 2);
+  memcpy(book_move->word_, book_entry + BOOK_ENTRY_SIZE - BOOK_WORD_SIZE,
+         word_size);
+  book_move->word_[word_size] = eos;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function fieldPositionHash, we hash the packed position of a
+/// field. The hash is never 0, which marks free book slots.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param player1_points holds the value of the points for player 1.
+/// @param player2_points holds the value of the points for player 2.
+/// @param player_turn the player who moves next.
+/// @param hash receives the hash.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return error_return_value if the field cannot be packed.
+/// @return SUCCESS otherwise.
+//
+int fieldPositionHash(Word** game_play_field,
+                      const BoardKernels* board_kernels, int player1_points,
+                      int player2_points, int player_turn,
+                      unsigned long long* hash)
+{
+  int error_return_value = 1;
+  int packed_size = 0;
+  unsigned char* packed = (unsigned char*)malloc(
+      packedPositionMaxSize(board_kernels->field_size_));
+  if(packed == NULL)
+    return OUT_MEMORY_ERROR;
+  if(encodePackedPosition(game_play_field, board_kernels, player1_points,
+                          player2_points, player_turn, packed,
+                          &packed_size) != SUCCESS)
+  {
+    free(packed);
+    return error_return_value;
+  }
+  *hash = hashPackedPosition(packed, packed_size);
+  if(*hash == 0)
+    *hash = 1;
+  free(packed);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameStatePositionHash, we hash the packed position of a
+/// running game.
+///
+/// @param game_state the running game.
+/// @param hash receives the hash.
+///
+/// @return return_value of fieldPositionHash.
+//
+int gameStatePositionHash(GameState* game_state, unsigned long long* hash)
+{
+  return fieldPositionHash(game_state->game_play_field_,
+                           &game_state->board_kernels_,
+                           game_state->player1_points_,
+                           game_state->player2_points_,
+                           game_state->player_turn_, hash);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function fieldBookMove, we look a position up in an opening book.
+/// A move which does not fit the field is not returned.
+///
+/// @param opening_book the book, may be empty.
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table letters and points of the game.
+/// @param player1_points holds the value of the points for player 1.
+/// @param player2_points holds the value of the points for player 2.
+/// @param player_turn the player who moves next.
+/// @param book_move receives the move.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return error_return_value if the book has no move for the position.
+/// @return SUCCESS otherwise.
+//
+int fieldBookMove(const OpeningBook* opening_book, Word** game_play_field,
+                  const BoardKernels* board_kernels,
+                  const LetterTable* letter_table, int player1_points,
+                  int player2_points, int player_turn, FieldMove* book_move)
+{
+  int error_return_value = 1;
+  if(opening_book->map_ == NULL)
+    return error_return_value;
+  unsigned long long hash = 0;
+  int return_value = fieldPositionHash(game_play_field, board_kernels,
+                                       player1_points, player2_points,
+                                       player_turn, &hash);
+  if(return_value != SUCCESS)
+    return return_value;
+  if(lookupOpeningBook(opening_book, hash, book_move) != SUCCESS)
+    return error_return_value;
+  if(fieldPlacementCheck(game_play_field, board_kernels, book_move->row_,
+                         book_move->column_, book_move->orientation_,
+                         book_move->word_, (int)strlen(book_move->word_),
+                         letter_table) != SUCCESS)
+    return error_return_value;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameStateBookMove, we look the current position of a
+/// running game up in its opening book.
+///
+/// @param game_state the running game.
+/// @param book_move receives the move.
+///
+/// @return return_value of fieldBookMove.
+//
+int gameStateBookMove(GameState* game_state, FieldMove* book_move)
+{
+  return fieldBookMove(&game_state->opening_book_,
+                       game_state->game_play_field_,
+                       &game_state->board_kernels_,
+                       &game_state->letter_table_,
+                       game_state->player1_points_,
+                       game_state->player2_points_,
+                       game_state->player_turn_, book_move);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printBookMove, we print the opening book move for the
+/// current position as an insert command.
+///
+/// @param game_state the running game.
+///
+/// @return
+//
+void printBookMove(GameState* game_state)
+{
+  FieldMove book_move;
+  int return_value = gameStateBookMove(game_state, &book_move);
+  if(return_value == OUT_MEMORY_ERROR)
+  {
+    printf("Error: Out of memory\n");
+    return;
+  }
+  if(return_value != SUCCESS)
+  {
+    printf("No book move for this position.\n");
+    return;
+  }
+  printf("Book move: ");
+  printFieldMove(&book_move);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printFieldMove, we print a move as the insert command
+/// which plays it, followed by its points.
+///
+/// @param field_move the move.
+///
+/// @return
+//
+void printFieldMove(const FieldMove* field_move)
+{
+  char eos = '\0';
+  char horizontal = 'H';
+  char vertical = 'V';
+  char row_text[MAX_COORDINATE_LENGTH + 1];
+  char column_text[MAX_COORDINATE_LENGTH + 1];
+  formatFieldCoordinate(field_move->row_, row_text);
+  formatFieldCoordinate(field_move->column_, column_text);
+  char orientation_text = horizontal;
+  if(field_move->orientation_)
+    orientation_text = vertical;
+  char word_text[MOVE_WORD_SIZE];
+  int word_iterator = 0;
+  for(word_iterator = 0; field_move->word_[word_iterator] != eos;
+      word_iterator++)
+    word_text[word_iterator] = (char)toupper(field_move->word_[word_iterator]);
+  word_text[word_iterator] = eos;
+  printf("insert %s %s %c %s (%d points)\n", row_text, column_text,
+         orientation_text, word_text, field_move->points_);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function buildOpeningBook, we build an opening book offline. For
+/// every config the best move of the word list is searched, played for both
+/// players and stored for each of the first BOOK_LINE_DEPTH positions.
+///
+/// @param book_name name of the book file to write.
+/// @param word_list_name name of the word list file.
+/// @param config_names names of the config files.
+/// @param config_count the number of config files.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if a file cannot be read or written.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return return_value of loadGameState otherwise.
+//
+int buildOpeningBook(char* book_name, char* word_list_name,
+                     char** config_names, int config_count)
+{
+  WordList word_list;
+  int return_value = loadWordList(word_list_name, &word_list);
+  if(return_value == CANNOT_OPEN_CONFIG_FILE)
+    printf("Error: Cannot open file: %s\n", word_list_name);
+  if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+  if(return_value != SUCCESS)
+    return return_value;
+  // the moves are searched in the word list, the games get no dictionary
+  Dictionary no_dictionary;
+  memset(&no_dictionary, 0, sizeof(Dictionary));
+
+  // at most half of the slots are used, so probing stays short
+  unsigned int slot_count = 1;
+  while(slot_count < 2u * (unsigned int)config_count * BOOK_LINE_DEPTH)
+    slot_count <<= 1;
+  size_t book_size = BOOK_HEADER_SIZE + (size_t)slot_count * BOOK_ENTRY_SIZE;
+  unsigned char* book = (unsigned char*)calloc(book_size, 1);
+  if(book == NULL)
+  {
+    freeWordList(&word_list);
+    printf("Error: Out of memory\n");
+    return OUT_MEMORY_ERROR;
+  }
+  unsigned char* book_slots = book + BOOK_HEADER_SIZE;
+
+  unsigned int entry_count = 0;
+  int config_iterator = 0;
+  for(config_iterator = 0;
+      (return_value == SUCCESS) && (config_iterator < config_count);
+      config_iterator++)
+  {
+    GameState game_state;
+    return_value = loadGameState(config_names[config_iterator], &game_state,
+                                 &no_dictionary);
+    if(return_value != SUCCESS)
+      break;
+    int depth_iterator = 0;
+    for(depth_iterator = 0; depth_iterator < BOOK_LINE_DEPTH; depth_iterator++)
+    {
+      unsigned long long hash = 0;
+      return_value = gameStatePositionHash(&game_state, &hash);
+      if(return_value != SUCCESS)
+      {
+        if(return_value != OUT_MEMORY_ERROR)
+          return_value = SUCCESS;
+        break;
+      }
+      unsigned char* book_entry =
+          book_slots +
+          (size_t)findBookSlot(book_slots, slot_count, hash) * BOOK_ENTRY_SIZE;
+      FieldMove best_move;
+      if((getDeltaValue(book_entry, 4) | getDeltaValue(book_entry + 4, 4)) != 0)
+        getBookEntry(book_entry, &best_move);
+      else if(searchBestMove(game_state.game_play_field_,
+                             &game_state.board_kernels_,
+                             &game_state.letter_table_, &word_list,
+                             &best_move) == SUCCESS)
+      {
+        putBookEntry(book_entry, hash, &best_move);
+        entry_count++;
+      }
+      else
+        break;
+
+      int points_won = 0;
+      return_value = gameStateInsertWord(&game_state, best_move.row_,
+                                         best_move.column_,
+                                         best_move.orientation_,
+                                         best_move.word_,
+                                         (int)strlen(best_move.word_),
+                                         &points_won);
+      if(return_value != OUT_MEMORY_ERROR)
+        return_value = SUCCESS;
+      if(return_value != SUCCESS)
+        break;
+      if(gameStateWinner(&game_state))
+        break;
+    }
+    freeGameState(&game_state);
+  }
+
+  if(return_value == SUCCESS)
+  {
+    memcpy(book, BOOK_MAGIC, BOOK_MAGIC_SIZE);
+    putDeltaValue(book + BOOK_MAGIC_SIZE, slot_count, 4);
+    putDeltaValue(book + 12, entry_count, 4);
+    return_value = writeMappedFile(book_name, book, book_size);
+    if(return_value == SUCCESS)
+      printf("%u positions written to %s\n", entry_count, book_name);
+    else if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Cannot open file: %s\n", book_name);
+  }
+  if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+  free(book);
+  freeWordList(&word_list);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function writeMappedFile, we write a file next to the old one and
+/// rename it over it, so games which mapped the old file keep reading it.
+///
+/// @param file_name name of the file, like the opening book.
+/// @param content the bytes of the file.
+/// @param content_size the number of bytes.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be written.
+/// @return SUCCESS otherwise.
+//
+int writeMappedFile(const char* file_name, const unsigned char* content,
+                    size_t content_size)
+{
+  char temp_suffix[] = ".tmp";
+  char* temp_name = (char*)malloc(strlen(file_name) + sizeof(temp_suffix));
+  if(temp_name == NULL)
+    return OUT_MEMORY_ERROR;
+  strcpy(temp_name, file_name);
+  strcat(temp_name, temp_suffix);
+
+  int return_value = SUCCESS;
+  FILE* mapped_file = fopen(temp_name, "wb");
+  if(mapped_file == NULL)
+    return_value = CANNOT_OPEN_CONFIG_FILE;
+  else
+  {
+    if((fwrite(content, 1, content_size, mapped_file) != content_size) ||
+       (fflush(mapped_file) != 0) || (fsync(fileno(mapped_file)) != 0))
+      return_value = CANNOT_OPEN_CONFIG_FILE;
+    if(fclose(mapped_file) != 0)
+      return_value = CANNOT_OPEN_CONFIG_FILE;
+    if((return_value == SUCCESS) && (rename(temp_name, file_name) != 0))
+      return_value = CANNOT_OPEN_CONFIG_FILE;
+    if(return_value != SUCCESS)
+      remove(temp_name);
+  }
+  free(temp_name);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function compareWordPointers, we compare two words for qsort.
+///
+/// @param first_word pointer to the first word.
+/// @param second_word pointer to the second word.
+///
+/// @return the order of the words like strcmp.
+//
+int compareWordPointers(const void* first_word, const void* second_word)
+{
+  return strcmp(*(const char* const*)first_word,
+                *(const char* const*)second_word);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function buildDictionary, we build the trie of a word list. Words
+/// longer than a move can hold are left out.
+///
+/// @param word_list the words.
+/// @param dictionary receives the trie.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int buildDictionary(const WordList* word_list, Dictionary* dictionary)
+{
+  memset(dictionary, 0, sizeof(Dictionary));
+  const char** sorted_words =
+      (const char**)malloc((word_list->count_ + 1) * sizeof(const char*));
+  if(sorted_words == NULL)
+    return OUT_MEMORY_ERROR;
+  int word_count = 0;
+  int letter_count = 0;
+  int word_iterator = 0;
+  for(word_iterator = 0; word_iterator < word_list->count_; word_iterator++)
+  {
+    int word_size = word_list->sizes_[word_iterator];
+    if(word_size >= MOVE_WORD_SIZE)
+      continue;
+    sorted_words[word_count++] =
+        word_list->words_ + word_list->offsets_[word_iterator];
+    letter_count += word_size;
+    if(word_size > dictionary->max_word_size_)
+      dictionary->max_word_size_ = word_size;
+  }
+  qsort(sorted_words, word_count, sizeof(const char*), compareWordPointers);
+
+  // every letter adds at most one node
+  dictionary->nodes_ =
+      (DictionaryNode*)malloc((letter_count + 1) * sizeof(DictionaryNode));
+  if(dictionary->nodes_ == NULL)
+  {
+    free(sorted_words);
+    return OUT_MEMORY_ERROR;
+  }
+  dictionary->node_count_ = 1;
+  dictionary->nodes_[0].parent_ = 0;
+  dictionary->nodes_[0].letter_ = 0;
+  fillDictionaryNode(dictionary, sorted_words, 0, word_count, 0, 0);
+  free(sorted_words);
+
+  DictionaryNode* fitted_nodes = (DictionaryNode*)realloc(
+      dictionary->nodes_, dictionary->node_count_ * sizeof(DictionaryNode));
+  if(fitted_nodes != NULL)
+    dictionary->nodes_ = fitted_nodes;
+  int return_value = buildAnchorIndex(dictionary);
+  if(return_value != SUCCESS)
+    return return_value;
+  return buildAnagramIndex(dictionary);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function buildAnchorIndex, we sort the nodes by depth and letter.
+/// Children always come after their parent, so the depths are known in one
+/// pass.
+///
+/// @param dictionary the trie.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int buildAnchorIndex(Dictionary* dictionary)
+{
+  int slot_count = dictionary->max_word_size_ * ALPHABET_SIZE;
+  int node_count = dictionary->node_count_;
+  int* node_depths = (int*)malloc(node_count * sizeof(int));
+  dictionary->anchor_offsets_ = (int*)calloc(slot_count + 1, sizeof(int));
+  dictionary->anchor_nodes_ = (int*)malloc(node_count * sizeof(int));
+  if((node_depths == NULL) || (dictionary->anchor_offsets_ == NULL) ||
+     (dictionary->anchor_nodes_ == NULL))
+  {
+    free(node_depths);
+    return OUT_MEMORY_ERROR;
+  }
+
+  node_depths[0] = 0;
+  int node_iterator = 0;
+  for(node_iterator = 1; node_iterator < node_count; node_iterator++)
+  {
+    const DictionaryNode* dictionary_node = &dictionary->nodes_[node_iterator];
+    node_depths[node_iterator] = node_depths[dictionary_node->parent_] + 1;
+    dictionary->anchor_offsets_[(node_depths[node_iterator] - 1) *
+                                ALPHABET_SIZE + dictionary_node->letter_ + 1]++;
+  }
+  int slot_iterator = 0;
+  for(slot_iterator = 0; slot_iterator < slot_count; slot_iterator++)
+    dictionary->anchor_offsets_[slot_iterator + 1] +=
+        dictionary->anchor_offsets_[slot_iterator];
+  // the offsets are moved along while filling and moved back afterwards
+  for(node_iterator = 1; node_iterator < node_count; node_iterator++)
+  {
+    int anchor_slot = (node_depths[node_iterator] - 1) * ALPHABET_SIZE +
+                      dictionary->nodes_[node_iterator].letter_;
+    dictionary->anchor_nodes_[dictionary->anchor_offsets_[anchor_slot]++] =
+        node_iterator;
+  }
+  for(slot_iterator = slot_count; slot_iterator > 0; slot_iterator--)
+    dictionary->anchor_offsets_[slot_iterator] =
+        dictionary->anchor_offsets_[slot_iterator - 1];
+  dictionary->anchor_offsets_[0] = 0;
+  free(node_depths);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function fillDictionaryNode, we fill the node of the words
+/// sharing their first depth letters and create its children one after
+/// another.
+///
+/// @param dictionary the trie being built.
+/// @param sorted_words the words in sorted order.
+/// @param first_word the first word of the node.
+/// @param word_end one after the last word of the node.
+/// @param depth the number of letters the words share.
+/// @param node_index the node to fill.
+///
+/// @return
+//
+void fillDictionaryNode(Dictionary* dictionary, const char** sorted_words,
+                        int first_word, int word_end, int depth,
+                        int node_index)
+{
+  char eos = '\0';
+  char small_a = 'a';
+  DictionaryNode* dictionary_node = &dictionary->nodes_[node_index];
+  dictionary_node->child_mask_ = 0;
+  dictionary_node->word_end_ = 0;
+
+  // shorter words come first, equal words are counted once
+  while((first_word < word_end) && (sorted_words[first_word][depth] == eos))
+  {
+    if(!dictionary_node->word_end_)
+      dictionary->word_count_++;
+    dictionary_node->word_end_ = 1;
+    first_word++;
+  }
+  int word_iterator = 0;
+  for(word_iterator = first_word; word_iterator < word_end; word_iterator++)
+    dictionary_node->child_mask_ |=
+        1u << (sorted_words[word_iterator][depth] - small_a);
+  dictionary_node->first_child_ = dictionary->node_count_;
+  dictionary->node_count_ += __builtin_popcount(dictionary_node->child_mask_);
+
+  dictionary_node->longest_suffix_ = 0;
+  int child_index = dictionary_node->first_child_;
+  while(first_word < word_end)
+  {
+    char child_letter = sorted_words[first_word][depth];
+    int child_end = first_word;
+    while((child_end < word_end) &&
+          (sorted_words[child_end][depth] == child_letter))
+      child_end++;
+    dictionary->nodes_[child_index].parent_ = node_index;
+    dictionary->nodes_[child_index].letter_ =
+        (unsigned char)(child_letter - small_a);
+    fillDictionaryNode(dictionary, sorted_words, first_word, child_end,
+                       depth + 1, child_index);
+    // the nodes are allocated at once, so the pointer stays valid
+    if(dictionary->nodes_[child_index].longest_suffix_ + 1 >
+       dictionary_node->longest_suffix_)
+      dictionary_node->longest_suffix_ =
+          dictionary->nodes_[child_index].longest_suffix_ + 1;
+    child_index++;
+    first_word = child_end;
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function loadDictionary, we read a word list file into a trie.
+/// An image of the list built by buildDictionaryImage is mapped instead, so
+/// all games share one copy of it.
+///
+/// @param word_list_name name of the word list file.
+/// @param dictionary receives the trie, empty in case of problems.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be read.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int loadDictionary(const char* word_list_name, Dictionary* dictionary)
+{
+  int return_value = openDictionaryImage(word_list_name, dictionary);
+  if((return_value == SUCCESS) || (return_value == OUT_MEMORY_ERROR))
+    return return_value;
+  WordList word_list;
+  return_value = loadWordList(word_list_name, &word_list);
+  if(return_value != SUCCESS)
+    return return_value;
+  return_value = buildDictionary(&word_list, dictionary);
+  freeWordList(&word_list);
+  if(return_value != SUCCESS)
+    freeDictionary(dictionary);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function freeDictionary, we free the trie of a dictionary or
+/// unmap its image.
+///
+/// @param dictionary the dictionary, may be empty.
+///
+/// @return
+//
+void freeDictionary(Dictionary* dictionary)
+{
+  if(dictionary->image_ != NULL)
+  {
+    munmap((void*)dictionary->image_, dictionary->image_size_);
+    memset(dictionary, 0, sizeof(Dictionary));
+    return;
+  }
+  free(dictionary->nodes_);
+  free(dictionary->anchor_offsets_);
+  free(dictionary->anchor_nodes_);
+  free(dictionary->anagram_nodes_);
+  free(dictionary->anagram_offsets_);
+  free(dictionary->anagram_slots_);
+  free(dictionary->anagram_keys_);
+  memset(dictionary, 0, sizeof(Dictionary));
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function compilePattern, we prepare a find pattern. A letter
+/// matches itself, '?' matches one letter and '*' any number of letters.
+///
+/// @param pattern the lowercased pattern.
+/// @param pattern_search receives the letters of every pattern position.
+///
+/// @return error_invalid_param if the pattern is too long or holds other
+///                             characters.
+/// @return SUCCESS otherwise.
+//
+int compilePattern(const char* pattern, PatternSearch* pattern_search)
+{
+  char eos = '\0';
+  char small_a = 'a';
+  char small_z = 'z';
+  char any_letter = '?';
+  char any_letters = '*';
+  int error_invalid_param = 2;
+  unsigned int all_letters = (1u << ALPHABET_SIZE) - 1;
+
+  pattern_search->pattern_size_ = 0;
+  pattern_search->pattern_repeats_ = 0;
+  int pattern_iterator = 0;
+  for(pattern_iterator = 0; pattern[pattern_iterator] != eos;
+      pattern_iterator++)
+  {
+    char pattern_char = pattern[pattern_iterator];
+    int pattern_position = pattern_search->pattern_size_;
+    // runs of '*' match the same as a single one
+    if((pattern_char == any_letters) && (pattern_position > 0) &&
+       (pattern_search->pattern_repeats_ & (1u << (pattern_position - 1))))
+      continue;
+    if(pattern_position >= SEGMENT_VECTOR_SIZE - 1)
+      return error_invalid_param;
+
+    if(pattern_char == any_letters)
+    {
+      pattern_search->pattern_letters_[pattern_position] = all_letters;
+      pattern_search->pattern_repeats_ |= 1u << pattern_position;
+    }
+    else if(pattern_char == any_letter)
+      pattern_search->pattern_letters_[pattern_position] = all_letters;
+    else if((pattern_char >= small_a) && (pattern_char <= small_z))
+      pattern_search->pattern_letters_[pattern_position] =
+          1u << (pattern_char - small_a);
+    else
+      return error_invalid_param;
+    pattern_search->pattern_size_++;
+  }
+  if(pattern_search->pattern_size_ == 0)
+    return error_invalid_param;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function patternClosure, we add the positions after every '*'
+/// which is reached, as '*' may match no letter.
+///
+/// @param pattern_search the compiled pattern.
+/// @param pattern_states the matched positions.
+///
+/// @return pattern_states with the positions after '*' added.
+//
+unsigned int patternClosure(const PatternSearch* pattern_search,
+                            unsigned int pattern_states)
+{
+  int pattern_position = 0;
+  for(pattern_position = 0; pattern_position < pattern_search->pattern_size_;
+      pattern_position++)
+    if((pattern_states & pattern_search->pattern_repeats_) &
+       (1u << pattern_position))
+      pattern_states |= 1u << (pattern_position + 1);
+  return pattern_states;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function patternStep, we match one more letter against every
+/// matched position.
+///
+/// @param pattern_search the compiled pattern.
+/// @param pattern_states the matched positions.
+/// @param letter_index the letter, 0 for 'a'.
+///
+/// @return next_states the positions matched afterwards, 0 if none.
+//
+unsigned int patternStep(const PatternSearch* pattern_search,
+                         unsigned int pattern_states, int letter_index)
+{
+  unsigned int next_states = 0;
+  unsigned int open_states =
+      pattern_states & ((1u << pattern_search->pattern_size_) - 1);
+  while(open_states)
+  {
+    int pattern_position = __builtin_ctz(open_states);
+    open_states &= open_states - 1;
+    if(!(pattern_search->pattern_letters_[pattern_position] &
+         (1u << letter_index)))
+      continue;
+    if(pattern_search->pattern_repeats_ & (1u << pattern_position))
+      next_states |= 1u << pattern_position;
+    else
+      next_states |= 1u << (pattern_position + 1);
+  }
+  return patternClosure(pattern_search, next_states);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function walkPatternSearch, we follow the dictionary along the
+/// line from the start of the search. A letter on the field allows only
+/// itself, free cells allow the letters of the game. Branches which the
+/// pattern cannot match anymore, or whose words end before the next letter
+/// on the field while none was overlapped yet, are not entered.
+///
+/// @param pattern_search the running search.
+/// @param node_index the dictionary node of the letters so far.
+/// @param pattern_states the pattern positions matched so far.
+/// @param word_size the number of letters so far.
+/// @param overlapped 1 if a letter so far is already on the field.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int walkPatternSearch(PatternSearch* pattern_search, int node_index,
+                      unsigned int pattern_states, int word_size,
+                      int overlapped)
+{
+  char space = ' ';
+  char small_a = 'a';
+  const DictionaryNode* dictionary_node =
+      &pattern_search->dictionary_->nodes_[node_index];
+  if((pattern_search->deadline_ > 0) &&
+     (++pattern_search->clock_counter_ % SEARCH_CLOCK_INTERVAL == 0) &&
+     (benchmarkSeconds() > pattern_search->deadline_))
+    pattern_search->timed_out_ = 1;
+  if(pattern_search->timed_out_)
+    return SUCCESS;
+  unsigned int final_state = 1u << pattern_search->pattern_size_;
+  if(dictionary_node->word_end_ && (pattern_states & final_state) &&
+     (overlapped || pattern_search->field_empty_))
+  {
+    if(addPatternMove(pattern_search, word_size) == OUT_MEMORY_ERROR)
+      return OUT_MEMORY_ERROR;
+  }
+  int line_position = pattern_search->start_ + word_size;
+  if((line_position >= pattern_search->line_size_) ||
+     (word_size >= MOVE_WORD_SIZE - 1))
+    return SUCCESS;
+  if(!overlapped && !pattern_search->field_empty_ &&
+     (pattern_search->next_letter_[line_position] - line_position >=
+      dictionary_node->longest_suffix_))
+    return SUCCESS;
+
+  unsigned int pattern_letters = 0;
+  unsigned int open_states = pattern_states & (final_state - 1);
+  while(open_states)
+  {
+    pattern_letters |=
+        pattern_search->pattern_letters_[__builtin_ctz(open_states)];
+    open_states &= open_states - 1;
+  }
+  unsigned int letter_mask = dictionary_node->child_mask_ & pattern_letters;
+  char field_char = pattern_search->field_line_[line_position];
+  int occupied = (field_char != space);
+  if(occupied)
+  {
+    int field_letter = field_char - small_a;
+    if((field_letter < 0) || (field_letter >= ALPHABET_SIZE))
+      return SUCCESS;
+    letter_mask &= 1u << field_letter;
+  }
+  else
+    letter_mask &= pattern_search->available_letters_;
+
+  while(letter_mask)
+  {
+    int letter_index = __builtin_ctz(letter_mask);
+    letter_mask &= letter_mask - 1;
+    unsigned int next_states = patternStep(pattern_search, pattern_states,
+                                           letter_index);
+    if(next_states == 0)
+      continue;
+    int child_index = dictionary_node->first_child_ +
+        __builtin_popcount(dictionary_node->child_mask_ &
+                           ((1u << letter_index) - 1));
+    pattern_search->word_[word_size] = (char)(small_a + letter_index);
+    if(!occupied && (--pattern_search->letters_left_[letter_index] == 0))
+      pattern_search->available_letters_ &= ~(1u << letter_index);
+    if(walkPatternSearch(pattern_search, child_index, next_states,
+                         word_size + 1, overlapped || occupied) ==
+       OUT_MEMORY_ERROR)
+      return OUT_MEMORY_ERROR;
+    if(!occupied && (pattern_search->letters_left_[letter_index]++ == 0))
+      pattern_search->available_letters_ |= 1u << letter_index;
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function walkAnchoredSearch, we start a search whose first cells
+/// are free from the dictionary nodes which put the first letter on the
+/// field at the right place. The free letters before it are read back
+/// through the parents and matched against the pattern.
+///
+/// @param pattern_search the running search.
+/// @param anchor_distance the number of free cells before the letter.
+/// @param anchor_letter the letter on the field, 0 for 'a'.
+/// @param start_states the pattern positions matched by no letter.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int walkAnchoredSearch(PatternSearch* pattern_search, int anchor_distance,
+                       int anchor_letter, unsigned int start_states)
+{
+  char small_a = 'a';
+  const Dictionary* dictionary = pattern_search->dictionary_;
+  if((anchor_letter < 0) || (anchor_letter >= ALPHABET_SIZE))
+    return SUCCESS;
+  int anchor_slot = anchor_distance * ALPHABET_SIZE + anchor_letter;
+  int anchor_iterator = 0;
+  for(anchor_iterator = dictionary->anchor_offsets_[anchor_slot];
+      anchor_iterator < dictionary->anchor_offsets_[anchor_slot + 1];
+      anchor_iterator++)
+  {
+    if(pattern_search->timed_out_)
+      break;
+    int node_index = dictionary->anchor_nodes_[anchor_iterator];
+    int prefix_index = dictionary->nodes_[node_index].parent_;
+    int letters_free = 1;
+    int word_iterator = 0;
+    for(word_iterator = anchor_distance - 1; word_iterator >= 0;
+        word_iterator--)
+    {
+      int letter_index = dictionary->nodes_[prefix_index].letter_;
+      if(!(pattern_search->available_letters_ & (1u << letter_index)))
+        letters_free = 0;
+      pattern_search->word_[word_iterator] = (char)(small_a + letter_index);
+      prefix_index = dictionary->nodes_[prefix_index].parent_;
+    }
+    if(!letters_free)
+      continue;
+    int letters_used[ALPHABET_SIZE];
+    memset(letters_used, 0, sizeof(letters_used));
+    for(word_iterator = 0; word_iterator < anchor_distance; word_iterator++)
+    {
+      int letter_index = pattern_search->word_[word_iterator] - small_a;
+      if(++letters_used[letter_index] >
+         pattern_search->letters_left_[letter_index])
+        letters_free = 0;
+    }
+    if(!letters_free)
+      continue;
+    pattern_search->word_[anchor_distance] = (char)(small_a + anchor_letter);
+
+    unsigned int pattern_states = start_states;
+    for(word_iterator = 0; (pattern_states != 0) &&
+        (word_iterator <= anchor_distance); word_iterator++)
+      pattern_states = patternStep(pattern_search, pattern_states,
+                                   pattern_search->word_[word_iterator] -
+                                   small_a);
+    if(pattern_states == 0)
+      continue;
+    // the free letters are taken for the walk and given back afterwards
+    unsigned int available_letters = pattern_search->available_letters_;
+    int letter_index = 0;
+    for(letter_index = 0; letter_index < ALPHABET_SIZE; letter_index++)
+    {
+      pattern_search->letters_left_[letter_index] -=
+          letters_used[letter_index];
+      if(pattern_search->letters_left_[letter_index] == 0)
+        pattern_search->available_letters_ &= ~(1u << letter_index);
+    }
+    if(walkPatternSearch(pattern_search, node_index, pattern_states,
+                         anchor_distance + 1, 1) == OUT_MEMORY_ERROR)
+      return OUT_MEMORY_ERROR;
+    for(letter_index = 0; letter_index < ALPHABET_SIZE; letter_index++)
+      pattern_search->letters_left_[letter_index] +=
+          letters_used[letter_index];
+    pattern_search->available_letters_ = available_letters;
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function addPatternMove, we store the word of a search as a move
+/// with the points the insert would give.
+///
+/// @param pattern_search the running search.
+/// @param word_size the number of letters of the word.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int addPatternMove(PatternSearch* pattern_search, int word_size)
+{
+  char eos = '\0';
+  char space = ' ';
+  char small_a = 'a';
+  pattern_search->word_[word_size] = eos;
+  if(checkWordInput(pattern_search->word_, word_size,
+                    pattern_search->letter_table_) != SUCCESS)
+    return SUCCESS;
+
+  FieldMove new_move;
+  new_move.orientation_ = pattern_search->orientation_;
+  new_move.row_ = pattern_search->line_index_;
+  new_move.column_ = pattern_search->start_;
+  if(pattern_search->orientation_)
+  {
+    new_move.row_ = pattern_search->start_;
+    new_move.column_ = pattern_search->line_index_;
+  }
+  new_move.points_ = 0;
+  int word_iterator = 0;
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+    if(pattern_search->field_line_[pattern_search->start_ + word_iterator] ==
+       space)
+      new_move.points_ += pattern_search->letter_table_->points_[
+          pattern_search->word_[word_iterator] - small_a];
+  memcpy(new_move.word_, pattern_search->word_, word_size + 1);
+
+  // with a limit the worst kept move is replaced by better ones
+  if((pattern_search->move_limit_ > 0) &&
+     (pattern_search->move_count_ == pattern_search->move_limit_))
+  {
+    FieldMove* worst_move =
+        &pattern_search->moves_[pattern_search->worst_move_];
+    if(compareFieldMoves(&new_move, worst_move) >= 0)
+      return SUCCESS;
+    *worst_move = new_move;
+    int move_iterator = 0;
+    for(move_iterator = 0; move_iterator < pattern_search->move_count_;
+        move_iterator++)
+      if(compareFieldMoves(&pattern_search->moves_[move_iterator],
+                           &pattern_search->moves_[
+                               pattern_search->worst_move_]) > 0)
+        pattern_search->worst_move_ = move_iterator;
+    return SUCCESS;
+  }
+  FieldMove* field_move = appendFieldMove(&pattern_search->moves_,
+                                          &pattern_search->move_count_,
+                                          &pattern_search->move_capacity_);
+  if(field_move == NULL)
+    return OUT_MEMORY_ERROR;
+  *field_move = new_move;
+  if((pattern_search->move_count_ == 1) ||
+     (compareFieldMoves(field_move, &pattern_search->moves_[
+         pattern_search->worst_move_]) > 0))
+    pattern_search->worst_move_ = pattern_search->move_count_ - 1;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function compareFieldMoves, we order moves by points, the most
+/// first, and then by their place and word.
+///
+/// @param first_move pointer to the first move.
+/// @param second_move pointer to the second move.
+///
+/// @return the order of the moves.
+//
+int compareFieldMoves(const void* first_move, const void* second_move)
+{
+  const FieldMove* first = (const FieldMove*)first_move;
+  const FieldMove* second = (const FieldMove*)second_move;
+  if(first->points_ != second->points_)
+    return second->points_ - first->points_;
+  if(first->row_ != second->row_)
+    return first->row_ - second->row_;
+  if(first->column_ != second->column_)
+    return first->column_ - second->column_;
+  if(first->orientation_ != second->orientation_)
+    return first->orientation_ - second->orientation_;
+  return strcmp(first->word_, second->word_);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function findPatternMoves, we find every placement of a
+/// dictionary word matching the pattern which an insert would accept, the
+/// most points first.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table letters and points of the game.
+/// @param dictionary the words.
+/// @param pattern the lowercased pattern.
+/// @param moves receives the moves, to be freed by the caller.
+/// @param move_count receives the number of moves.
+///
+/// @return error_invalid_param if the pattern is not valid.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int findPatternMoves(Word** game_play_field, const BoardKernels* board_kernels,
+                     const LetterTable* letter_table,
+                     const Dictionary* dictionary, const char* pattern,
+                     FieldMove** moves, int* move_count)
+{
+  int orientation_count = 2;
+  int field_size = board_kernels->field_size_;
+  *moves = NULL;
+  *move_count = 0;
+
+  PatternSearch pattern_search;
+  int return_value = initializePatternSearch(&pattern_search,
+                                             game_play_field, board_kernels,
+                                             letter_table, dictionary,
+                                             pattern, NULL);
+  if(return_value != SUCCESS)
+    return return_value;
+  if(dictionary->nodes_ == NULL)
+    return SUCCESS;
+  int orientation = 0;
+  for(orientation = 0; orientation < orientation_count; orientation++)
+  {
+    int line_index = 0;
+    for(line_index = 0;
+        (return_value == SUCCESS) && (line_index < field_size); line_index++)
+      return_value = searchPatternLine(&pattern_search, game_play_field,
+                                       board_kernels, orientation,
+                                       line_index, 0);
+  }
+  if(return_value != SUCCESS)
+  {
+    free(pattern_search.moves_);
+    return return_value;
+  }
+  qsort(pattern_search.moves_, pattern_search.move_count_, sizeof(FieldMove),
+        compareFieldMoves);
+  *moves = pattern_search.moves_;
+  *move_count = pattern_search.move_count_;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function initializePatternSearch, we prepare a search of the
+/// whole dictionary, without a move limit or deadline.
+///
+/// @param pattern_search receives the search.
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table letters and points of the game.
+/// @param dictionary the words.
+/// @param pattern the lowercased pattern.
+/// @param rack the letters free cells may take, NULL or empty for any.
+///
+/// @return error_invalid_param if the pattern is not valid.
+/// @return SUCCESS otherwise.
+//
+int initializePatternSearch(PatternSearch* pattern_search,
+                            Word** game_play_field,
+                            const BoardKernels* board_kernels,
+                            const LetterTable* letter_table,
+                            const Dictionary* dictionary, const char* pattern,
+                            const char* rack)
+{
+  char eos = '\0';
+  char small_a = 'a';
+  int return_value = compilePattern(pattern, pattern_search);
+  if(return_value != SUCCESS)
+    return return_value;
+  pattern_search->dictionary_ = dictionary;
+  pattern_search->letter_table_ = letter_table;
+  pattern_search->line_size_ = board_kernels->field_size_;
+  pattern_search->field_empty_ =
+      board_kernels->check_empty_(game_play_field, board_kernels->field_size_);
+  pattern_search->available_letters_ = 0;
+  int letter_iterator = 0;
+  for(letter_iterator = 0; letter_iterator < ALPHABET_SIZE; letter_iterator++)
+  {
+    pattern_search->letters_left_[letter_iterator] = 0;
+    if((rack == NULL) || (*rack == eos))
+      pattern_search->letters_left_[letter_iterator] = MOVE_WORD_SIZE;
+  }
+  while((rack != NULL) && (*rack != eos))
+    pattern_search->letters_left_[*rack++ - small_a]++;
+  for(letter_iterator = 0; letter_iterator < ALPHABET_SIZE; letter_iterator++)
+    if((letter_table->counts_[letter_iterator] > 0) &&
+       (pattern_search->letters_left_[letter_iterator] > 0))
+      pattern_search->available_letters_ |= 1u << letter_iterator;
+  pattern_search->moves_ = NULL;
+  pattern_search->move_count_ = 0;
+  pattern_search->move_capacity_ = 0;
+  pattern_search->move_limit_ = 0;
+  pattern_search->worst_move_ = 0;
+  pattern_search->deadline_ = 0;
+  pattern_search->clock_counter_ = 0;
+  pattern_search->timed_out_ = 0;
+  pattern_search->start_states_ = patternClosure(pattern_search, 1u);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function searchPatternLine, we add the placements of one row or
+/// column to a search. If the deadline passes, start_ is left at the first
+/// cell not done and the moves found from it are dropped again.
+///
+/// @param pattern_search the running search.
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param orientation 0 for a row, otherwise a column.
+/// @param line_index the row or column, counted from 0.
+/// @param first_start the first cell of the line to start words at.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int searchPatternLine(PatternSearch* pattern_search, Word** game_play_field,
+                      const BoardKernels* board_kernels, int orientation,
+                      int line_index, int first_start)
+{
+  char space = ' ';
+  char small_a = 'a';
+  int field_size = board_kernels->field_size_;
+  const Dictionary* dictionary = pattern_search->dictionary_;
+  char field_line[FIELD_SEGMENT_BUFFER];
+  int next_letter[FIELD_SEGMENT_BUFFER];
+  pattern_search->field_line_ = field_line;
+  pattern_search->next_letter_ = next_letter;
+  pattern_search->orientation_ = orientation;
+  pattern_search->line_index_ = line_index;
+
+  int first_row = line_index;
+  int first_column = 0;
+  if(orientation)
+  {
+    first_row = 0;
+    first_column = line_index;
+  }
+  board_kernels->load_segment_(game_play_field, field_size, first_row,
+                               first_column, orientation, field_size,
+                               field_line);
+  next_letter[field_size] = field_size;
+  int cell_iterator = 0;
+  for(cell_iterator = field_size - 1; cell_iterator >= 0; cell_iterator--)
+  {
+    next_letter[cell_iterator] = next_letter[cell_iterator + 1];
+    if(field_line[cell_iterator] != space)
+      next_letter[cell_iterator] = cell_iterator;
+  }
+
+  int return_value = SUCCESS;
+  int start = 0;
+  for(start = first_start; (return_value == SUCCESS) && (start < field_size);
+      start++)
+  {
+    pattern_search->start_ = start;
+    int anchor_distance = next_letter[start] - start;
+    if(pattern_search->field_empty_ || (anchor_distance == 0))
+      return_value = walkPatternSearch(pattern_search, 0,
+                                       pattern_search->start_states_, 0, 0);
+    else if(anchor_distance < dictionary->max_word_size_)
+      return_value = walkAnchoredSearch(
+          pattern_search, anchor_distance,
+          field_line[next_letter[start]] - small_a,
+          pattern_search->start_states_);
+    if(pattern_search->timed_out_)
+      break;
+  }
+  pattern_search->start_ = start;
+  if(!pattern_search->timed_out_)
+    return return_value;
+
+  int move_count = 0;
+  int move_iterator = 0;
+  for(move_iterator = 0; move_iterator < pattern_search->move_count_;
+      move_iterator++)
+  {
+    const FieldMove* field_move = &pattern_search->moves_[move_iterator];
+    int move_line = field_move->row_;
+    int move_start = field_move->column_;
+    if(field_move->orientation_)
+    {
+      move_line = field_move->column_;
+      move_start = field_move->row_;
+    }
+    if((field_move->orientation_ == orientation) &&
+       (move_line == line_index) && (move_start == start))
+      continue;
+    pattern_search->moves_[move_count++] = *field_move;
+  }
+  pattern_search->move_count_ = move_count;
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printFindMoves, we print the best placements matching a
+/// pattern as insert commands and how many there are.
+///
+/// @param game_state the running game.
+/// @param pattern the lowercased pattern, NULL if it is missing.
+///
+/// @return
+//
+void printFindMoves(GameState* game_state, const char* pattern)
+{
+  if(pattern == NULL)
+  {
+    printf("Error: Insert parameters not valid!\n");
+    return;
+  }
+  if(game_state->dictionary_.nodes_ == NULL)
+  {
+    printf("Error: No dictionary loaded!\n");
+    return;
+  }
+  FieldMove* moves = NULL;
+  int move_count = 0;
+  int return_value = findPatternMoves(game_state->game_play_field_,
+                                      &game_state->board_kernels_,
+                                      &game_state->letter_table_,
+                                      &game_state->dictionary_, pattern,
+                                      &moves, &move_count);
+  if(return_value == OUT_MEMORY_ERROR)
+  {
+    printf("Error: Out of memory\n");
+    return;
+  }
+  if(return_value != SUCCESS)
+  {
+    printf("Error: Insert parameters not valid!\n");
+    return;
+  }
+  int move_iterator = 0;
+  for(move_iterator = 0;
+      (move_iterator < move_count) && (move_iterator < FIND_PRINT_LIMIT);
+      move_iterator++)
+    printFieldMove(&moves[move_iterator]);
+  printf("%d placements found.\n", move_count);
+  free(moves);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function appendFieldMove, we make room for one more move at the
+/// end of a growing move array.
+///
+/// @param moves the moves, reallocated if they are full.
+/// @param move_count the number of moves, counted up.
+/// @param move_capacity the number of moves which fit.
+///
+/// @return NULL if the memory could not be allocated.
+/// @return the new move otherwise.
+//
+FieldMove* appendFieldMove(FieldMove** moves, int* move_count,
+                           int* move_capacity)
+{
+  int first_capacity = 64;
+  if(*move_count == *move_capacity)
+  {
+    int new_capacity = *move_capacity * 2;
+    if(new_capacity == 0)
+      new_capacity = first_capacity;
+    FieldMove* new_moves = (FieldMove*)realloc(*moves, new_capacity *
+                                               sizeof(FieldMove));
+    if(new_moves == NULL)
+      return NULL;
+    *moves = new_moves;
+    *move_capacity = new_capacity;
+  }
+  FieldMove* field_move = &(*moves)[*move_count];
+  (*move_count)++;
+  return field_move;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function dictionaryWord, we read the word ending at a node back
+/// through the parents.
+///
+/// @param dictionary the trie.
+/// @param node_index the node of the last letter.
+/// @param word receives the letters, ended with eos.
+///
+/// @return the number of letters.
+//
+int dictionaryWord(const Dictionary* dictionary, int node_index, char* word)
+{
+  char eos = '\0';
+  char small_a = 'a';
+  int word_size = 0;
+  int parent_index = node_index;
+  while(parent_index != 0)
+  {
+    word_size++;
+    parent_index = dictionary->nodes_[parent_index].parent_;
+  }
+  word[word_size] = eos;
+  int word_iterator = 0;
+  for(word_iterator = word_size - 1; word_iterator >= 0; word_iterator--)
+  {
+    word[word_iterator] =
+        (char)(small_a + dictionary->nodes_[node_index].letter_);
+    node_index = dictionary->nodes_[node_index].parent_;
+  }
+  return word_size;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function anagramLetterKey, we give every letter a random looking
+/// 64 bit key. The key of a set of letters is the sum of the keys, so
+/// adding a letter adds its key.
+///
+/// @param letter the letter, 0 for 'a'.
+///
+/// @return the key of the letter.
+//
+unsigned long long anagramLetterKey(int letter)
+{
+  unsigned long long key = (unsigned long long)(letter + 1) * ANAGRAM_KEY_SEED;
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+  return key ^ (key >> 31);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function compareAnagramEntries, we order words by their sorted
+/// letters, so anagrams end up next to each other.
+///
+/// @param first_entry pointer to the first entry.
+/// @param second_entry pointer to the second entry.
+///
+/// @return the order of the entries.
+//
+int compareAnagramEntries(const void* first_entry, const void* second_entry)
+{
+  const AnagramEntry* first = (const AnagramEntry*)first_entry;
+  const AnagramEntry* second = (const AnagramEntry*)second_entry;
+  int signature_order = strcmp(first->signature_, second->signature_);
+  if(signature_order != 0)
+    return signature_order;
+  return first->node_ - second->node_;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function buildAnagramIndex, we group the words of the trie by
+/// their letters and put the groups into a hash table of their keys.
+///
+/// @param dictionary the trie.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int buildAnagramIndex(Dictionary* dictionary)
+{
+  char small_a = 'a';
+  AnagramEntry* anagram_entries = (AnagramEntry*)malloc(
+      (dictionary->word_count_ + 1) * sizeof(AnagramEntry));
+  if(anagram_entries == NULL)
+    return OUT_MEMORY_ERROR;
+  int entry_count = 0;
+  int node_iterator = 0;
+  for(node_iterator = 1; node_iterator < dictionary->node_count_;
+      node_iterator++)
+  {
+    if(!dictionary->nodes_[node_iterator].word_end_)
+      continue;
+    AnagramEntry* anagram_entry = &anagram_entries[entry_count++];
+    anagram_entry->node_ = node_iterator;
+    int word_size = dictionaryWord(dictionary, node_iterator,
+                                   anagram_entry->signature_);
+    // words are short, sorting by insertion is enough
+    int letter_iterator = 0;
+    for(letter_iterator = 1; letter_iterator < word_size; letter_iterator++)
+    {
+      char letter = anagram_entry->signature_[letter_iterator];
+      int sorted_iterator = letter_iterator;
+      while((sorted_iterator > 0) &&
+            (anagram_entry->signature_[sorted_iterator - 1] > letter))
+      {
+        anagram_entry->signature_[sorted_iterator] =
+            anagram_entry->signature_[sorted_iterator - 1];
+        sorted_iterator--;
+      }
+      anagram_entry->signature_[sorted_iterator] = letter;
+    }
+  }
+  qsort(anagram_entries, entry_count, sizeof(AnagramEntry),
+        compareAnagramEntries);
+
+  int class_count = 0;
+  int entry_iterator = 0;
+  for(entry_iterator = 0; entry_iterator < entry_count; entry_iterator++)
+    if((entry_iterator == 0) ||
+       (strcmp(anagram_entries[entry_iterator - 1].signature_,
+               anagram_entries[entry_iterator].signature_) != 0))
+      class_count++;
+  int slot_count = 2;
+  while(slot_count < 2 * class_count)
+    slot_count *= 2;
+  dictionary->anagram_nodes_ = (int*)malloc((entry_count + 1) * sizeof(int));
+  dictionary->anagram_offsets_ = (int*)malloc((class_count + 1) *
+                                              sizeof(int));
+  dictionary->anagram_slots_ = (int*)calloc(slot_count, sizeof(int));
+  dictionary->anagram_keys_ = (unsigned long long*)malloc(
+      (class_count + 1) * sizeof(unsigned long long));
+  if((dictionary->anagram_nodes_ == NULL) ||
+     (dictionary->anagram_offsets_ == NULL) ||
+     (dictionary->anagram_slots_ == NULL) ||
+     (dictionary->anagram_keys_ == NULL))
+  {
+    free(anagram_entries);
+    return OUT_MEMORY_ERROR;
+  }
+  dictionary->anagram_class_count_ = class_count;
+  dictionary->anagram_slot_count_ = slot_count;
+
+  int class_index = -1;
+  for(entry_iterator = 0; entry_iterator < entry_count; entry_iterator++)
+  {
+    const AnagramEntry* anagram_entry = &anagram_entries[entry_iterator];
+    dictionary->anagram_nodes_[entry_iterator] = anagram_entry->node_;
+    if((entry_iterator > 0) &&
+       (strcmp(anagram_entries[entry_iterator - 1].signature_,
+               anagram_entry->signature_) == 0))
+      continue;
+    class_index++;
+    dictionary->anagram_offsets_[class_index] = entry_iterator;
+    unsigned long long key = 0;
+    const char* signature = anagram_entry->signature_;
+    while(*signature)
+      key += anagramLetterKey(*signature++ - small_a);
+    dictionary->anagram_keys_[class_index] = key;
+    unsigned int slot = (unsigned int)key & (slot_count - 1);
+    while(dictionary->anagram_slots_[slot] != 0)
+      slot = (slot + 1) & (slot_count - 1);
+    dictionary->anagram_slots_[slot] = class_index + 1;
+  }
+  dictionary->anagram_offsets_[class_count] = entry_count;
+  free(anagram_entries);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function findAnagramClass, we look up the words made of exactly
+/// the given letters. Classes with the same key are told apart by the
+/// letters of their first word.
+///
+/// @param dictionary the trie with its anagram index.
+/// @param key the sum of the letter keys.
+/// @param letter_counts how often every letter is used.
+///
+/// @return -1 if no word has these letters.
+/// @return the anagram class otherwise.
+//
+int findAnagramClass(const Dictionary* dictionary, unsigned long long key,
+                     const int* letter_counts)
+{
+  char small_a = 'a';
+  int no_class = -1;
+  unsigned int slot_mask = dictionary->anagram_slot_count_ - 1;
+  unsigned int slot = (unsigned int)key & slot_mask;
+  while(dictionary->anagram_slots_[slot] != 0)
+  {
+    int class_index = dictionary->anagram_slots_[slot] - 1;
+    slot = (slot + 1) & slot_mask;
+    if(dictionary->anagram_keys_[class_index] != key)
+      continue;
+    char word[MOVE_WORD_SIZE];
+    int word_size = dictionaryWord(dictionary, dictionary->anagram_nodes_[
+        dictionary->anagram_offsets_[class_index]], word);
+    int class_counts[ALPHABET_SIZE];
+    memset(class_counts, 0, sizeof(class_counts));
+    int word_iterator = 0;
+    for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+      class_counts[word[word_iterator] - small_a]++;
+    if(memcmp(class_counts, letter_counts, sizeof(class_counts)) == 0)
+      return class_index;
+  }
+  return no_class;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function collectAnagramClasses, we try every count of the
+/// letters from letter_index on and keep the anagram classes which exist.
+///
+/// @param rack_search the running query.
+/// @param letter_index the first letter still to count, 0 for 'a'.
+/// @param key the sum of the keys of the letters counted so far.
+/// @param letter_total the number of letters counted so far.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int collectAnagramClasses(RackSearch* rack_search, int letter_index,
+                          unsigned long long key, int letter_total)
+{
+  int first_capacity = 64;
+  if(letter_index == ALPHABET_SIZE)
+  {
+    if(letter_total == 0)
+      return SUCCESS;
+    int class_index = findAnagramClass(rack_search->dictionary_, key,
+                                       rack_search->letter_counts_);
+    if(class_index < 0)
+      return SUCCESS;
+    if(rack_search->class_count_ == rack_search->class_capacity_)
+    {
+      int class_capacity = rack_search->class_capacity_ * 2;
+      if(class_capacity == 0)
+        class_capacity = first_capacity;
+      int* classes = (int*)realloc(rack_search->classes_,
+                                   class_capacity * sizeof(int));
+      if(classes == NULL)
+        return OUT_MEMORY_ERROR;
+      rack_search->classes_ = classes;
+      rack_search->class_capacity_ = class_capacity;
+    }
+    rack_search->classes_[rack_search->class_count_++] = class_index;
+    return SUCCESS;
+  }
+
+  int letter_limit = rack_search->letter_limits_[letter_index];
+  int letter_count = 0;
+  if(letter_index == rack_search->fixed_letter_)
+    letter_count = letter_limit;
+  for(; letter_count <= letter_limit; letter_count++)
+  {
+    rack_search->letter_counts_[letter_index] = letter_count;
+    if(collectAnagramClasses(rack_search, letter_index + 1,
+                             key + letter_count *
+                             rack_search->letter_keys_[letter_index],
+                             letter_total + letter_count) == OUT_MEMORY_ERROR)
+      return OUT_MEMORY_ERROR;
+  }
+  rack_search->letter_counts_[letter_index] = 0;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function addRackMove, we keep a placement if it does not conflict
+/// with the field and the rack holds the letters of its free cells.
+///
+/// @param rack_search the running query.
+/// @param row first row of the word, counted from 0.
+/// @param column first column of the word, counted from 0.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param word the lowercased word.
+/// @param word_size the number of letters in the word.
+/// @param field_segment the cells below the word.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int addRackMove(RackSearch* rack_search, int row, int column, int orientation,
+                const char* word, int word_size, const char* field_segment)
+{
+  char space = ' ';
+  char small_a = 'a';
+  int letters_used[ALPHABET_SIZE];
+  memset(letters_used, 0, sizeof(letters_used));
+  int points = 0;
+  int word_iterator = 0;
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+  {
+    int letter_index = word[word_iterator] - small_a;
+    if(field_segment[word_iterator] != space)
+    {
+      if(field_segment[word_iterator] != word[word_iterator])
+        return SUCCESS;
+      continue;
+    }
+    letters_used[letter_index]++;
+    if(letters_used[letter_index] > rack_search->rack_counts_[letter_index])
+      return SUCCESS;
+    points += rack_search->letter_table_->points_[letter_index];
+  }
+
+  FieldMove* field_move = appendFieldMove(&rack_search->moves_,
+                                          &rack_search->move_count_,
+                                          &rack_search->move_capacity_);
+  if(field_move == NULL)
+    return OUT_MEMORY_ERROR;
+  field_move->row_ = row;
+  field_move->column_ = column;
+  field_move->orientation_ = orientation;
+  field_move->points_ = points;
+  memcpy(field_move->word_, word, word_size + 1);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function addRackPlacements, we place a word everywhere it fits.
+/// On a field with letters only the cells holding one of the letters of
+/// the word are tried, each placement from its first overlapping letter.
+///
+/// @param rack_search the running query.
+/// @param word the lowercased word.
+/// @param word_size the number of letters in the word.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int addRackPlacements(RackSearch* rack_search, const char* word,
+                      int word_size)
+{
+  char space = ' ';
+  char small_a = 'a';
+  int orientation_count = 2;
+  int field_size = rack_search->board_kernels_->field_size_;
+  if(word_size > field_size)
+    return SUCCESS;
+  char field_segment[FIELD_SEGMENT_BUFFER];
+  int orientation = 0;
+  for(orientation = 0; orientation < orientation_count; orientation++)
+  {
+    if(rack_search->field_empty_)
+    {
+      memset(field_segment, space, word_size);
+      int line_index = 0;
+      for(line_index = 0; line_index < field_size; line_index++)
+      {
+        int start = 0;
+        for(start = 0; start + word_size <= field_size; start++)
+        {
+          int row = line_index;
+          int column = start;
+          if(orientation)
+          {
+            row = start;
+            column = line_index;
+          }
+          if(addRackMove(rack_search, row, column, orientation, word,
+                         word_size, field_segment) == OUT_MEMORY_ERROR)
+            return OUT_MEMORY_ERROR;
+        }
+      }
+      continue;
+    }
+
+    int word_iterator = 0;
+    for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+    {
+      int letter_index = word[word_iterator] - small_a;
+      int cell_iterator = 0;
+      for(cell_iterator = rack_search->letter_offsets_[letter_index];
+          cell_iterator < rack_search->letter_offsets_[letter_index + 1];
+          cell_iterator++)
+      {
+        int row = rack_search->letter_cells_[cell_iterator] / field_size;
+        int column = rack_search->letter_cells_[cell_iterator] % field_size;
+        int start = column - word_iterator;
+        if(orientation)
+          start = row - word_iterator;
+        if((start < 0) || (start + word_size > field_size))
+          continue;
+        if(orientation)
+          row = start;
+        else
+          column = start;
+        rack_search->board_kernels_->load_segment_(
+            rack_search->game_play_field_, field_size, row, column,
+            orientation, word_size, field_segment);
+        int first_overlap = 0;
+        while(field_segment[first_overlap] == space)
+          first_overlap++;
+        if(first_overlap != word_iterator)
+          continue;
+        if(addRackMove(rack_search, row, column, orientation, word,
+                       word_size, field_segment) == OUT_MEMORY_ERROR)
+          return OUT_MEMORY_ERROR;
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function loadLetterCells, we list the cells of the field by the
+/// letter they hold, a cell being row * field size + column.
+///
+/// @param rack_search the running query, receives the cells.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int loadLetterCells(RackSearch* rack_search)
+{
+  char small_a = 'a';
+  int field_size = rack_search->board_kernels_->field_size_;
+  int letter_totals[ALPHABET_SIZE + 1];
+  memset(letter_totals, 0, sizeof(letter_totals));
+  char field_line[FIELD_SEGMENT_BUFFER];
+  int row = 0;
+  int column = 0;
+  for(row = 0; row < field_size; row++)
+  {
+    rack_search->board_kernels_->load_segment_(
+        rack_search->game_play_field_, field_size, row, 0, 0, field_size,
+        field_line);
+    for(column = 0; column < field_size; column++)
+    {
+      int letter_index = field_line[column] - small_a;
+      if((letter_index >= 0) && (letter_index < ALPHABET_SIZE))
+        letter_totals[letter_index + 1]++;
+    }
+  }
+  int letter_iterator = 0;
+  for(letter_iterator = 0; letter_iterator < ALPHABET_SIZE; letter_iterator++)
+    letter_totals[letter_iterator + 1] += letter_totals[letter_iterator];
+  memcpy(rack_search->letter_offsets_, letter_totals, sizeof(letter_totals));
+  rack_search->letter_cells_ =
+      (int*)malloc((letter_totals[ALPHABET_SIZE] + 1) * sizeof(int));
+  if(rack_search->letter_cells_ == NULL)
+    return OUT_MEMORY_ERROR;
+
+  // letter_totals is moved along to the end of every letter
+  for(row = 0; row < field_size; row++)
+  {
+    rack_search->board_kernels_->load_segment_(
+        rack_search->game_play_field_, field_size, row, 0, 0, field_size,
+        field_line);
+    for(column = 0; column < field_size; column++)
+    {
+      int letter_index = field_line[column] - small_a;
+      if((letter_index >= 0) && (letter_index < ALPHABET_SIZE))
+        rack_search->letter_cells_[letter_totals[letter_index]++] =
+            row * field_size + column;
+    }
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function findRackMoves, we find every placement of a word made of
+/// the rack and at most one letter on the field, the most points first.
+/// The words come from the anagram index, one lookup per subset of the
+/// letters, so the dictionary is never scanned.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table letters and points of the game.
+/// @param dictionary the words.
+/// @param rack the lowercased letters of the player.
+/// @param moves receives the moves, to be freed by the caller.
+/// @param move_count receives the number of moves.
+/// @param word_count receives the number of words which can be formed.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int findRackMoves(Word** game_play_field, const BoardKernels* board_kernels,
+                  const LetterTable* letter_table,
+                  const Dictionary* dictionary, const char* rack,
+                  FieldMove** moves, int* move_count, int* word_count)
+{
+  char small_a = 'a';
+  int no_letter = -1;
+  *moves = NULL;
+  *move_count = 0;
+  *word_count = 0;
+  if(dictionary->anagram_nodes_ == NULL)
+    return SUCCESS;
+
+  RackSearch rack_search;
+  memset(&rack_search, 0, sizeof(RackSearch));
+  rack_search.dictionary_ = dictionary;
+  rack_search.game_play_field_ = game_play_field;
+  rack_search.board_kernels_ = board_kernels;
+  rack_search.letter_table_ = letter_table;
+  int letter_iterator = 0;
+  for(letter_iterator = 0; letter_iterator < ALPHABET_SIZE; letter_iterator++)
+    rack_search.letter_keys_[letter_iterator] =
+        anagramLetterKey(letter_iterator);
+  while(*rack)
+    rack_search.rack_counts_[*rack++ - small_a]++;
+  memcpy(rack_search.letter_limits_, rack_search.rack_counts_,
+         sizeof(rack_search.letter_limits_));
+  rack_search.field_empty_ =
+      board_kernels->check_empty_(game_play_field, board_kernels->field_size_);
+
+  int return_value = loadLetterCells(&rack_search);
+  // words of the rack alone, then words taking one letter of the field
+  rack_search.fixed_letter_ = no_letter;
+  if(return_value == SUCCESS)
+    return_value = collectAnagramClasses(&rack_search, 0, 0, 0);
+  for(letter_iterator = 0;
+      (return_value == SUCCESS) && (letter_iterator < ALPHABET_SIZE);
+      letter_iterator++)
+  {
+    if(rack_search.letter_offsets_[letter_iterator] ==
+       rack_search.letter_offsets_[letter_iterator + 1])
+      continue;
+    rack_search.fixed_letter_ = letter_iterator;
+    rack_search.letter_limits_[letter_iterator]++;
+    return_value = collectAnagramClasses(&rack_search, 0, 0, 0);
+    rack_search.letter_limits_[letter_iterator]--;
+  }
+
+  int class_iterator = 0;
+  for(class_iterator = 0;
+      (return_value == SUCCESS) && (class_iterator < rack_search.class_count_);
+      class_iterator++)
+  {
+    int class_index = rack_search.classes_[class_iterator];
+    int entry_iterator = 0;
+    for(entry_iterator = dictionary->anagram_offsets_[class_index];
+        (return_value == SUCCESS) &&
+        (entry_iterator < dictionary->anagram_offsets_[class_index + 1]);
+        entry_iterator++)
+    {
+      char word[MOVE_WORD_SIZE];
+      int word_size = dictionaryWord(
+          dictionary, dictionary->anagram_nodes_[entry_iterator], word);
+      if(checkWordInput(word, word_size, letter_table) != SUCCESS)
+        continue;
+      (*word_count)++;
+      return_value = addRackPlacements(&rack_search, word, word_size);
+    }
+  }
+  free(rack_search.letter_cells_);
+  free(rack_search.classes_);
+  if(return_value != SUCCESS)
+  {
+    free(rack_search.moves_);
+    return return_value;
+  }
+  qsort(rack_search.moves_, rack_search.move_count_, sizeof(FieldMove),
+        compareFieldMoves);
+  *moves = rack_search.moves_;
+  *move_count = rack_search.move_count_;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printRackMoves, we print the best placements of the
+/// words the player to move can form from the rack.
+///
+/// @param game_state the running game.
+///
+/// @return
+//
+void printRackMoves(GameState* game_state)
+{
+  char eos = '\0';
+  const char* rack = game_state->racks_[game_state->player_turn_ - 1];
+  if(rack[0] == eos)
+  {
+    printf("Error: No rack set!\n");
+    return;
+  }
+  if(game_state->dictionary_.nodes_ == NULL)
+  {
+    printf("Error: No dictionary loaded!\n");
+    return;
+  }
+  FieldMove* moves = NULL;
+  int move_count = 0;
+  int word_count = 0;
+  if(findRackMoves(game_state->game_play_field_, &game_state->board_kernels_,
+                   &game_state->letter_table_, &game_state->dictionary_, rack,
+                   &moves, &move_count, &word_count) != SUCCESS)
+  {
+    printf("Error: Out of memory\n");
+    return;
+  }
+  int move_iterator = 0;
+  for(move_iterator = 0;
+      (move_iterator < move_count) && (move_iterator < FIND_PRINT_LIMIT);
+      move_iterator++)
+    printFieldMove(&moves[move_iterator]);
+  printf("%d words, %d placements found.\n", word_count, move_count);
+  free(moves);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameStateSetRack, we give the player to move a new rack
+/// and print it. Without letters the rack is only printed, "-" removes it.
+///
+/// @param game_state the running game.
+/// @param letters the lowercased letters, NULL if they are missing.
+///
+/// @return error_invalid_param if the letters are not valid.
+/// @return SUCCESS otherwise.
+//
+int gameStateSetRack(GameState* game_state, const char* letters)
+{
+  char eos = '\0';
+  char small_a = 'a';
+  char small_z = 'z';
+  int error_invalid_param = 2;
+  char* rack = game_state->racks_[game_state->player_turn_ - 1];
+  if((letters != NULL) && (strcmp(letters, "-") == 0))
+    rack[0] = eos;
+  else if(letters != NULL)
+  {
+    int rack_size = (int)strlen(letters);
+    if(rack_size > RACK_MAX_SIZE)
+      return error_invalid_param;
+    int letter_iterator = 0;
+    for(letter_iterator = 0; letter_iterator < rack_size; letter_iterator++)
+      if((letters[letter_iterator] < small_a) ||
+         (letters[letter_iterator] > small_z))
+        return error_invalid_param;
+    memcpy(rack, letters, rack_size + 1);
+  }
+  if(rack[0] == eos)
+    printf("Player %d has no rack.\n", game_state->player_turn_);
+  else
+    printf("Rack of player %d: %s\n", game_state->player_turn_, rack);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function rackLettersCheck, we check that the rack of the player
+/// to move holds the letters a word needs on free cells.
+///
+/// @param game_state the running game.
+/// @param row first row of the word, counted from 0.
+/// @param column first column of the word, counted from 0.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param word the lowercased word.
+/// @param word_size the number of letters in the word.
+/// @param rack_left receives the rack without these letters.
+///
+/// @return return_value of placementParameterCheck if the word cannot be
+///                      placed there.
+/// @return error_return_value if the rack misses letters.
+/// @return SUCCESS otherwise.
+//
+int rackLettersCheck(GameState* game_state, int row, int column,
+                     int orientation, const char* word, int word_size,
+                     char* rack_left)
+{
+  char space = ' ';
+  int error_return_value = 1;
+  int field_size = game_state->board_kernels_.field_size_;
+  int return_value = placementParameterCheck(field_size, row, column,
+                                             orientation, word, word_size,
+                                             &game_state->letter_table_);
+  if(return_value != SUCCESS)
+    return return_value;
+
+  char field_segment[FIELD_SEGMENT_BUFFER];
+  game_state->board_kernels_.load_segment_(game_state->game_play_field_,
+                                           field_size, row, column,
+                                           orientation, word_size,
+                                           field_segment);
+  strcpy(rack_left, game_state->racks_[game_state->player_turn_ - 1]);
+  int word_iterator = 0;
+  for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+  {
+    if(field_segment[word_iterator] != space)
+      continue;
+    char* rack_letter = strchr(rack_left, word[word_iterator]);
+    if(rack_letter == NULL)
+      return error_return_value;
+    memmove(rack_letter, rack_letter + 1, strlen(rack_letter + 1) + 1);
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function allocateHintLines, we allocate the moves of every line
+/// of a slot of the hint cache, all lines stale and for any letters.
+///
+/// @param hint_lines receives the lines.
+/// @param line_count the number of lines.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int allocateHintLines(HintLines* hint_lines, int line_count)
+{
+  hint_lines->moves_ = (FieldMove*)malloc(
+      line_count * HINT_LINE_CANDIDATES * sizeof(FieldMove));
+  hint_lines->counts_ = (int*)calloc(line_count, sizeof(int));
+  hint_lines->starts_ = (int*)calloc(line_count, sizeof(int));
+  if((hint_lines->moves_ == NULL) || (hint_lines->counts_ == NULL) ||
+     (hint_lines->starts_ == NULL))
+    return OUT_MEMORY_ERROR;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function clearHintLines, we mark every line of a slot stale.
+///
+/// @param hint_lines the lines.
+/// @param line_count the number of lines.
+///
+/// @return
+//
+void clearHintLines(HintLines* hint_lines, int line_count)
+{
+  memset(hint_lines->counts_, 0, line_count * sizeof(int));
+  memset(hint_lines->starts_, 0, line_count * sizeof(int));
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function clearHintCache, we mark every line of the hint cache
+/// stale.
+///
+/// @param hint_cache the cache.
+///
+/// @return
+//
+void clearHintCache(HintCache* hint_cache)
+{
+  int slot_iterator = 0;
+  for(slot_iterator = 0; slot_iterator < HINT_CACHE_SLOTS; slot_iterator++)
+    clearHintLines(&hint_cache->slots_[slot_iterator],
+                   hint_cache->line_count_);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function freeHintCache, we free the moves of the hint cache.
+///
+/// @param hint_cache the cache, may be empty.
+///
+/// @return
+//
+void freeHintCache(HintCache* hint_cache)
+{
+  int slot_iterator = 0;
+  for(slot_iterator = 0; slot_iterator < HINT_CACHE_SLOTS; slot_iterator++)
+  {
+    free(hint_cache->slots_[slot_iterator].moves_);
+    free(hint_cache->slots_[slot_iterator].counts_);
+    free(hint_cache->slots_[slot_iterator].starts_);
+  }
+  memset(hint_cache, 0, sizeof(HintCache));
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function touchHintCache, we mark the lines through the cells of
+/// an insert stale in every slot. On a field which was empty every line
+/// changes.
+///
+/// @param hint_cache the cache.
+/// @param field_size holds the size of the field.
+/// @param row first row of the word, counted from 0.
+/// @param column first column of the word, counted from 0.
+/// @param orientation 0 for horizontal, otherwise vertical.
+/// @param word_size the number of letters in the word.
+///
+/// @return
+//
+void touchHintCache(HintCache* hint_cache, int field_size, int row,
+                    int column, int orientation, int word_size)
+{
+  if(hint_cache->line_count_ == 0)
+    return;
+  if(hint_cache->field_empty_)
+  {
+    clearHintCache(hint_cache);
+    return;
+  }
+  int word_line = row;
+  int first_crossing = field_size + column;
+  if(orientation)
+  {
+    word_line = field_size + column;
+    first_crossing = row;
+  }
+  int slot_iterator = 0;
+  for(slot_iterator = 0; slot_iterator < HINT_CACHE_SLOTS; slot_iterator++)
+  {
+    HintLines* hint_lines = &hint_cache->slots_[slot_iterator];
+    hint_lines->counts_[word_line] = 0;
+    hint_lines->starts_[word_line] = 0;
+    int word_iterator = 0;
+    for(word_iterator = 0; word_iterator < word_size; word_iterator++)
+    {
+      hint_lines->counts_[first_crossing + word_iterator] = 0;
+      hint_lines->starts_[first_crossing + word_iterator] = 0;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function rackHoldsLetters, we check if the moves searched for one
+/// rack include every move of another one. An empty rack stands for any
+/// letters.
+///
+/// @param rack the rack the moves were searched for.
+/// @param letters the rack the moves are wanted for.
+///
+/// @return 1 if rack holds all of the letters.
+/// @return 0 otherwise.
+//
+int rackHoldsLetters(const char* rack, const char* letters)
+{
+  char eos = '\0';
+  char small_a = 'a';
+  if(rack[0] == eos)
+    return 1;
+  if(letters[0] == eos)
+    return 0;
+  int letters_left[ALPHABET_SIZE];
+  memset(letters_left, 0, sizeof(letters_left));
+  while(*rack != eos)
+    letters_left[*rack++ - small_a]++;
+  while(*letters != eos)
+    if(--letters_left[*letters++ - small_a] < 0)
+      return 0;
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function selectHintSlot, we choose the slot of the hint cache a
+/// rack is served from. A slot of the same rack comes first, then the
+/// slot of the smallest rack holding its letters, like the rack before an
+/// insert took letters from it. A slot for any letters is taken last and
+/// the least recently used one of them, so a player without a rack keeps
+/// its own. Without such a slot the least recently used slot is cleared.
+///
+/// @param hint_cache the cache.
+/// @param rack the rack of the player to move.
+///
+/// @return chosen_slot the index of the slot.
+//
+int selectHintSlot(HintCache* hint_cache, const char* rack)
+{
+  char eos = '\0';
+  int chosen_slot = -1;
+  int chosen_rank = 0;
+  int oldest_slot = 0;
+  int slot_iterator = 0;
+  for(slot_iterator = 0; slot_iterator < HINT_CACHE_SLOTS; slot_iterator++)
+  {
+    HintLines* hint_lines = &hint_cache->slots_[slot_iterator];
+    if(hint_lines->last_used_ <
+       hint_cache->slots_[oldest_slot].last_used_)
+      oldest_slot = slot_iterator;
+    if(!rackHoldsLetters(hint_lines->rack_, rack))
+      continue;
+    // lower ranks are better, an older slot wins among any letters
+    int slot_rank = 0;
+    if(strcmp(hint_lines->rack_, rack) != 0)
+      slot_rank = (int)strlen(hint_lines->rack_);
+    if(hint_lines->rack_[0] == eos)
+      slot_rank = RACK_MAX_SIZE + 1;
+    if((chosen_slot < 0) || (slot_rank < chosen_rank) ||
+       ((slot_rank == chosen_rank) && (slot_rank > RACK_MAX_SIZE) &&
+        (hint_lines->last_used_ <
+         hint_cache->slots_[chosen_slot].last_used_)))
+    {
+      chosen_slot = slot_iterator;
+      chosen_rank = slot_rank;
+    }
+  }
+  if(chosen_slot < 0)
+  {
+    chosen_slot = oldest_slot;
+    clearHintLines(&hint_cache->slots_[chosen_slot], hint_cache->line_count_);
+  }
+  return chosen_slot;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function searchHintLine, we search a line of a slot again if it
+/// is stale and the deadline of the search did not pass yet. The search
+/// goes on with the moves found so far on the line, which are kept sorted
+/// by compareFieldMoves.
+///
+/// @param pattern_search the search, with room for the moves of a line.
+/// @param hint_lines the slot.
+/// @param line the line.
+/// @param game_state the running game.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int searchHintLine(PatternSearch* pattern_search, HintLines* hint_lines,
+                   int line, GameState* game_state)
+{
+  int field_size = game_state->board_kernels_.field_size_;
+  if((hint_lines->starts_[line] >= field_size) ||
+     (pattern_search->timed_out_) ||
+     (benchmarkSeconds() >= pattern_search->deadline_))
+    return SUCCESS;
+
+  FieldMove* line_moves = &hint_lines->moves_[line * HINT_LINE_CANDIDATES];
+  memcpy(pattern_search->moves_, line_moves,
+         hint_lines->counts_[line] * sizeof(FieldMove));
+  pattern_search->move_count_ = hint_lines->counts_[line];
+  // the moves are sorted, so the worst one is the last
+  pattern_search->worst_move_ = 0;
+  if(pattern_search->move_count_ > 0)
+    pattern_search->worst_move_ = pattern_search->move_count_ - 1;
+  if(searchPatternLine(pattern_search, game_state->game_play_field_,
+                       &game_state->board_kernels_, line / field_size,
+                       line % field_size, hint_lines->starts_[line]) ==
+     OUT_MEMORY_ERROR)
+    return OUT_MEMORY_ERROR;
+  qsort(pattern_search->moves_, pattern_search->move_count_,
+        sizeof(FieldMove), compareFieldMoves);
+  memcpy(line_moves, pattern_search->moves_,
+         pattern_search->move_count_ * sizeof(FieldMove));
+  hint_lines->counts_[line] = pattern_search->move_count_;
+  hint_lines->starts_[line] = pattern_search->start_;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function rackHintMoves, we take the first moves of a line which
+/// the rack of the player to move can play. Without a rack every move can
+/// be played.
+///
+/// @param game_state the running game.
+/// @param line_moves the moves of the line, sorted by compareFieldMoves.
+/// @param line_count the number of moves of the line.
+/// @param move_limit the number of moves wanted.
+/// @param rack_moves receives the moves.
+///
+/// @return rack_count the number of moves taken.
+//
+int rackHintMoves(GameState* game_state, const FieldMove* line_moves,
+                  int line_count, int move_limit, FieldMove* rack_moves)
+{
+  char eos = '\0';
+  const char* rack = game_state->racks_[game_state->player_turn_ - 1];
+  char rack_left[RACK_MAX_SIZE + 1];
+  int rack_count = 0;
+  int move_iterator = 0;
+  for(move_iterator = 0;
+      (move_iterator < line_count) && (rack_count < move_limit);
+      move_iterator++)
+  {
+    const FieldMove* line_move = &line_moves[move_iterator];
+    if((rack[0] != eos) &&
+       (rackLettersCheck(game_state, line_move->row_, line_move->column_,
+                         line_move->orientation_, line_move->word_,
+                         (int)strlen(line_move->word_), rack_left) !=
+        SUCCESS))
+      continue;
+    rack_moves[rack_count] = *line_move;
+    rack_count++;
+  }
+  return rack_count;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function gameStateHint, we find the best moves of the player to
+/// move. Stale lines of the slot chosen for the rack are searched again
+/// until the deadline passes, the answer then only knows the cells searched
+/// so far. The moves of the slot are filtered by the rack, a full line
+/// with too few moves left is searched for the rack again. The slot is
+/// kept for the rack afterwards, every line of it was searched for a rack
+/// holding its letters.
+/// In a position of the opening book the book move comes first, if the
+/// rack holds its letters, and the search fills the other places. A single
+/// move wanted is the book move without a search.
+///
+/// @param game_state the running game, with a dictionary.
+/// @param move_limit the number of moves wanted, at most HINT_LINE_MOVES.
+/// @param deadline the time from benchmarkSeconds to stop searching at.
+/// @param moves receives the best moves.
+/// @param move_count receives the number of moves.
+/// @param lines_left receives the number of lines not fully searched.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int gameStateHint(GameState* game_state, int move_limit, double deadline,
+                  FieldMove* moves, int* move_count, int* lines_left)
+{
+  char eos = '\0';
+  int field_size = game_state->board_kernels_.field_size_;
+  int line_count = 2 * field_size;
+  HintCache* hint_cache = &game_state->hint_cache_;
+  const char* rack = game_state->racks_[game_state->player_turn_ - 1];
+  *move_count = 0;
+  *lines_left = 0;
+
+  FieldMove book_move;
+  int book_value = gameStateBookMove(game_state, &book_move);
+  if(book_value == OUT_MEMORY_ERROR)
+    return OUT_MEMORY_ERROR;
+  char rack_left[RACK_MAX_SIZE + 1];
+  int book_count = 0;
+  if((book_value == SUCCESS) && (move_limit > 0) &&
+     ((rack[0] == eos) ||
+      (rackLettersCheck(game_state, book_move.row_, book_move.column_,
+                        book_move.orientation_, book_move.word_,
+                        (int)strlen(book_move.word_), rack_left) == SUCCESS)))
+  {
+    moves[0] = book_move;
+    book_count = 1;
+    *move_count = book_count;
+    if(move_limit == book_count)
+      return SUCCESS;
+  }
+
+  int slot_iterator = 0;
+  for(slot_iterator = 0;
+      (hint_cache->line_count_ == 0) && (slot_iterator < HINT_CACHE_SLOTS);
+      slot_iterator++)
+  {
+    if(allocateHintLines(&hint_cache->slots_[slot_iterator], line_count) !=
+       SUCCESS)
+    {
+      freeHintCache(hint_cache);
+      return OUT_MEMORY_ERROR;
+    }
+  }
+  hint_cache->line_count_ = line_count;
+
+  PatternSearch pattern_search;
+  initializePatternSearch(&pattern_search, game_state->game_play_field_,
+                          &game_state->board_kernels_,
+                          &game_state->letter_table_,
+                          &game_state->dictionary_, "*", rack);
+  if(hint_cache->field_empty_ != pattern_search.field_empty_)
+  {
+    clearHintCache(hint_cache);
+    hint_cache->field_empty_ = pattern_search.field_empty_;
+  }
+  HintLines* hint_lines =
+      &hint_cache->slots_[selectHintSlot(hint_cache, rack)];
+  pattern_search.moves_ =
+      (FieldMove*)malloc(HINT_LINE_CANDIDATES * sizeof(FieldMove));
+  FieldMove* cached_moves =
+      (FieldMove*)malloc((line_count * move_limit + 1) * sizeof(FieldMove));
+  if((pattern_search.moves_ == NULL) || (cached_moves == NULL))
+  {
+    free(pattern_search.moves_);
+    free(cached_moves);
+    return OUT_MEMORY_ERROR;
+  }
+  pattern_search.move_capacity_ = HINT_LINE_CANDIDATES;
+  pattern_search.move_limit_ = HINT_LINE_CANDIDATES;
+  pattern_search.deadline_ = deadline;
+
+  int return_value = SUCCESS;
+  int cached_count = 0;
+  int line_iterator = 0;
+  for(line_iterator = 0;
+      (return_value == SUCCESS) && (line_iterator < line_count);
+      line_iterator++)
+  {
+    FieldMove* line_moves =
+        &hint_lines->moves_[line_iterator * HINT_LINE_CANDIDATES];
+    return_value = searchHintLine(&pattern_search, hint_lines,
+                                  line_iterator, game_state);
+    int rack_count = rackHintMoves(game_state, line_moves,
+                                   hint_lines->counts_[line_iterator],
+                                   move_limit, &cached_moves[cached_count]);
+    // a full line may have dropped moves the rack can play
+    if((return_value == SUCCESS) && (rack_count < move_limit) &&
+       (hint_lines->counts_[line_iterator] == HINT_LINE_CANDIDATES))
+    {
+      hint_lines->counts_[line_iterator] = 0;
+      hint_lines->starts_[line_iterator] = 0;
+      return_value = searchHintLine(&pattern_search, hint_lines,
+                                    line_iterator, game_state);
+      rack_count = rackHintMoves(game_state, line_moves,
+                                 hint_lines->counts_[line_iterator],
+                                 move_limit, &cached_moves[cached_count]);
+    }
+    if(hint_lines->starts_[line_iterator] < field_size)
+      (*lines_left)++;
+    cached_count += rack_count;
+  }
+  free(pattern_search.moves_);
+  strcpy(hint_lines->rack_, rack);
+  hint_cache->hint_count_++;
+  hint_lines->last_used_ = hint_cache->hint_count_;
+  if(return_value != SUCCESS)
+  {
+    free(cached_moves);
+    return return_value;
+  }
+
+  qsort(cached_moves, cached_count, sizeof(FieldMove), compareFieldMoves);
+  *move_count = book_count;
+  int move_iterator = 0;
+  for(move_iterator = 0;
+      (move_iterator < cached_count) && (*move_count < move_limit);
+      move_iterator++)
+  {
+    // the book move is not listed a second time
+    const FieldMove* cached_move = &cached_moves[move_iterator];
+    if((book_count > 0) && (cached_move->row_ == book_move.row_) &&
+       (cached_move->column_ == book_move.column_) &&
+       (cached_move->orientation_ == book_move.orientation_) &&
+       (strcmp(cached_move->word_, book_move.word_) == 0))
+      continue;
+    moves[*move_count] = *cached_move;
+    (*move_count)++;
+  }
+  free(cached_moves);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printHint, we print the best moves of the player to
+/// move as insert commands, searched for at most HINT_DEADLINE_MS.
+///
+/// @param game_state the running game.
+/// @param move_limit_text the number of moves wanted, NULL for the default.
+///
+/// @return
+//
+void printHint(GameState* game_state, const char* move_limit_text)
+{
+  int move_limit = HINT_DEFAULT_MOVES;
+  if(move_limit_text != NULL)
+    move_limit = atoi(move_limit_text);
+  if((move_limit < 1) || (move_limit > HINT_LINE_MOVES))
+  {
+    printf("Error: Insert parameters not valid!\n");
+    return;
+  }
+  if(game_state->dictionary_.nodes_ == NULL)
+  {
+    printf("Error: No dictionary loaded!\n");
+    return;
+  }
+  FieldMove moves[HINT_LINE_MOVES];
+  int move_count = 0;
+  int lines_left = 0;
+  double deadline = benchmarkSeconds() + HINT_DEADLINE_MS / 1000.0;
+  if(gameStateHint(game_state, move_limit, deadline, moves, &move_count,
+                   &lines_left) != SUCCESS)
+  {
+    printf("Error: Out of memory\n");
+    return;
+  }
+  if(move_count == 0)
+    printf("No move found.\n");
+  int move_iterator = 0;
+  for(move_iterator = 0; move_iterator < move_count; move_iterator++)
+  {
+    printf("Hint: ");
+    printFieldMove(&moves[move_iterator]);
+  }
+  if(lines_left > 0)
+    printf("Partial hint, %d lines were not fully searched in time.\n",
+           lines_left);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function parseTournamentPlayers, we read the automatic players
+/// of a tournament from a list separated by commas.
+///
+/// @param player_specs the list, like "greedy,top5+book,deadline20".
+/// @param players receives the players, to be freed by the caller.
+/// @param player_count receives the number of players.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return WRONG_ARGUMENTS_NR if a player is unknown.
+/// @return SUCCESS otherwise.
+//
+int parseTournamentPlayers(const char* player_specs,
+                           TournamentPlayer** players, int* player_count)
+{
+  char eos = '\0';
+  char separator = ',';
+  int top_size = 3;
+  int deadline_size = 8;
+  int book_suffix_size = 5;
+  *player_count = 1;
+  const char* spec_char = player_specs;
+  for(spec_char = player_specs; *spec_char != eos; spec_char++)
+    if(*spec_char == separator)
+      (*player_count)++;
+  *players = (TournamentPlayer*)calloc(*player_count,
+                                       sizeof(TournamentPlayer));
+  if(*players == NULL)
+    return OUT_MEMORY_ERROR;
+
+  const char* spec = player_specs;
+  int player_iterator = 0;
+  for(player_iterator = 0; player_iterator < *player_count; player_iterator++)
+  {
+    TournamentPlayer* player = &(*players)[player_iterator];
+    const char* spec_end = strchr(spec, separator);
+    if(spec_end == NULL)
+      spec_end = spec + strlen(spec);
+    int spec_size = (int)(spec_end - spec);
+    if(spec_size >= TOURNAMENT_NAME_SIZE)
+      spec_size = TOURNAMENT_NAME_SIZE - 1;
+    memcpy(player->name_, spec, spec_size);
+    player->name_[spec_size] = eos;
+    spec = spec_end + 1;
+
+    // the name keeps the suffix, so the standings tell both players apart
+    char strategy_name[TOURNAMENT_NAME_SIZE];
+    strcpy(strategy_name, player->name_);
+    if((spec_size > book_suffix_size) &&
+       (strcmp(strategy_name + spec_size - book_suffix_size,
+               TOURNAMENT_BOOK_SUFFIX) == 0))
+    {
+      player->book_ = 1;
+      strategy_name[spec_size - book_suffix_size] = eos;
+    }
+    if(strcmp(strategy_name, "greedy") == 0)
+      player->strategy_ = TOURNAMENT_GREEDY;
+    else if((strncmp(strategy_name, "top", top_size) == 0) &&
+            (atoi(strategy_name + top_size) > 0))
+    {
+      player->strategy_ = TOURNAMENT_TOP;
+      player->parameter_ = atoi(strategy_name + top_size);
+    }
+    else if((strncmp(strategy_name, "deadline", deadline_size) == 0) &&
+            (atoi(strategy_name + deadline_size) > 0))
+    {
+      player->strategy_ = TOURNAMENT_DEADLINE;
+      player->parameter_ = atoi(strategy_name + deadline_size);
+    }
+    else
+    {
+      printf("Error: Unknown player: %s\n", player->name_);
+      free(*players);
+      *players = NULL;
+      return WRONG_ARGUMENTS_NR;
+    }
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function loadTournamentBoard, we read a config file once and keep
+/// its position packed, so every game unpacks it instead of reading the
+/// file again.
+///
+/// @param config_name name of the config file.
+/// @param tournament_board receives the board.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be opened.
+/// @return INVALID_CONFIG_FILE if the file is not a config file.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int loadTournamentBoard(char* config_name, TournamentBoard* tournament_board)
+{
+  memset(tournament_board, 0, sizeof(TournamentBoard));
+  FILE* config_text = fopen(config_name, "r");
+  if(config_text == NULL)
+  {
+    printf("Error: Cannot open file: %s\n", config_name);
+    return CANNOT_OPEN_CONFIG_FILE;
+  }
+  char* char_points_string = NULL;
+  int player1_points = 0;
+  int player2_points = 0;
+  int field_size = 0;
+  int player_turn = 0;
+  int return_value = 0;
+  char** file_elements_array = getConfigContent(config_text, &return_value,
+                                                &char_points_string,
+                                                &player1_points,
+                                                &player2_points,
+                                                &field_size,
+                                                &player_turn);
+  if(file_elements_array == NULL)
+  {
+    if(return_value == INVALID_CONFIG_FILE)
+      printf("Error: Invalid file: %s\n", config_name);
+    return return_value;
+  }
+
+  tournament_board->config_name_ = config_name;
+  getBoardKernels(field_size, &tournament_board->board_kernels_);
+  buildLetterTable(char_points_string, &tournament_board->letter_table_);
+  Word** game_play_field = initializeGameField(
+      file_elements_array, char_points_string,
+      &tournament_board->board_kernels_);
+  if(game_play_field == NULL)
+    return OUT_MEMORY_ERROR;
+  // kept for the archive
+  tournament_board->char_points_string_ = char_points_string;
+  tournament_board->packed_ =
+      (unsigned char*)malloc(packedPositionMaxSize(field_size));
+  if(tournament_board->packed_ != NULL)
+    encodePackedPosition(game_play_field, &tournament_board->board_kernels_,
+                         player1_points, player2_points, player_turn,
+                         tournament_board->packed_,
+                         &tournament_board->packed_size_);
+  tournament_board->board_kernels_.free_field_(game_play_field, field_size);
+  if(tournament_board->packed_ == NULL)
+    return OUT_MEMORY_ERROR;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function tournamentMove, we let an automatic player choose its
+/// move. A player using the book plays the book move of a position in the
+/// opening book without a search.
+///
+/// @param player the player.
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table letters and points of the game.
+/// @param dictionary the words.
+/// @param opening_book the book, may be empty.
+/// @param player1_points holds the value of the points for player 1.
+/// @param player2_points holds the value of the points for player 2.
+/// @param player_turn the player to move.
+/// @param random_state state of the random numbers of the game.
+/// @param field_move receives the move.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return error_return_value if the player has no move.
+/// @return SUCCESS otherwise.
+//
+int tournamentMove(const TournamentPlayer* player, Word** game_play_field,
+                   const BoardKernels* board_kernels,
+                   const LetterTable* letter_table,
+                   const Dictionary* dictionary,
+                   const OpeningBook* opening_book, int player1_points,
+                   int player2_points, int player_turn,
+                   unsigned long long* random_state, FieldMove* field_move)
+{
+  int error_return_value = 1;
+  int orientation_count = 2;
+  int field_size = board_kernels->field_size_;
+  if(player->book_)
+  {
+    int book_value = fieldBookMove(opening_book, game_play_field,
+                                   board_kernels, letter_table,
+                                   player1_points, player2_points,
+                                   player_turn, field_move);
+    if(book_value != error_return_value)
+      return book_value;
+  }
+
+  PatternSearch pattern_search;
+  initializePatternSearch(&pattern_search, game_play_field, board_kernels,
+                          letter_table, dictionary, "*", NULL);
+  pattern_search.move_limit_ = 1;
+  if(player->strategy_ == TOURNAMENT_TOP)
+    pattern_search.move_limit_ = player->parameter_;
+  if(player->strategy_ == TOURNAMENT_DEADLINE)
+    pattern_search.deadline_ = benchmarkSeconds() +
+                               player->parameter_ / 1000.0;
+
+  int return_value = SUCCESS;
+  int line_iterator = 0;
+  for(line_iterator = 0; (return_value == SUCCESS) &&
+      (line_iterator < orientation_count * field_size) &&
+      !pattern_search.timed_out_; line_iterator++)
+    return_value = searchPatternLine(&pattern_search, game_play_field,
+                                     board_kernels, line_iterator / field_size,
+                                     line_iterator % field_size, 0);
+  if((return_value == SUCCESS) && (pattern_search.move_count_ == 0))
+    return_value = error_return_value;
+  if(return_value == SUCCESS)
+  {
+    int chosen_move = 0;
+    if(player->strategy_ == TOURNAMENT_TOP)
+    {
+      // xorshift, seeded per game so a tournament can be repeated
+      *random_state ^= *random_state << 13;
+      *random_state ^= *random_state >> 7;
+      *random_state ^= *random_state << 17;
+      chosen_move = (int)(*random_state % pattern_search.move_count_);
+    }
+    *field_move = pattern_search.moves_[chosen_move];
+  }
+  free(pattern_search.moves_);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function playTournamentGame, we play one game on a fresh copy of
+/// its board. The game ends when a player reaches the winning points or
+/// neither player has a move.
+///
+/// @param tournament the tournament.
+/// @param game_index the game, its board and players are set already.
+/// @param archive_game receives the moves of the game, its move buffers
+///                     are reused.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int playTournamentGame(Tournament* tournament, int game_index,
+                       ArchiveGame* archive_game)
+{
+  int player_1 = 1;
+  int player_2 = 2;
+  int pass_limit = 2;
+  TournamentGame* tournament_game = &tournament->games_[game_index];
+  const TournamentBoard* tournament_board =
+      &tournament->boards_[tournament_game->board_];
+  const BoardKernels* board_kernels = &tournament_board->board_kernels_;
+  int field_size = board_kernels->field_size_;
+  int winning_points = (field_size * field_size) / 2;
+  Word** game_play_field = board_kernels->create_field_(field_size);
+  if(game_play_field == NULL)
+    return OUT_MEMORY_ERROR;
+  int player1_points = 0;
+  int player2_points = 0;
+  int player_turn = player_1;
+  if(decodePackedPosition(tournament_board->packed_,
+                          tournament_board->packed_size_, game_play_field,
+                          board_kernels, &tournament_board->letter_table_,
+                          &player1_points, &player2_points,
+                          &player_turn) == OUT_MEMORY_ERROR)
+  {
+    board_kernels->free_field_(game_play_field, field_size);
+    return OUT_MEMORY_ERROR;
+  }
+
+  DeltaGame delta_game;
+  delta_game.game_ = (unsigned int)game_index;
+  publishSnapshotDelta(&tournament->delta_stream_, &delta_game,
+                       game_play_field, board_kernels, player1_points,
+                       player2_points, player_turn);
+
+  unsigned long long random_state =
+      ((unsigned long long)game_index + 1) * ANAGRAM_KEY_SEED;
+  archive_game->char_points_string_ = tournament_board->char_points_string_;
+  archive_game->field_size_ = field_size;
+  archive_game->packed_ = tournament_board->packed_;
+  archive_game->packed_size_ = tournament_board->packed_size_;
+  archive_game->move_count_ = 0;
+  int return_value = SUCCESS;
+  int pass_count = 0;
+  tournament_game->move_count_ = 0;
+  while((pass_count < pass_limit) &&
+        (tournament_game->move_count_ < field_size * field_size) &&
+        (player1_points < winning_points) && (player2_points < winning_points))
+  {
+    int player_index = tournament_game->first_;
+    if(player_turn != player_1)
+      player_index = tournament_game->second_;
+    FieldMove field_move;
+    return_value = tournamentMove(&tournament->players_[player_index],
+                                  game_play_field, board_kernels,
+                                  &tournament_board->letter_table_,
+                                  &tournament->dictionary_,
+                                  &tournament->opening_book_, player1_points,
+                                  player2_points, player_turn, &random_state,
+                                  &field_move);
+    if(return_value == OUT_MEMORY_ERROR)
+      break;
+    int points_won = 0;
+    if(return_value == SUCCESS)
+      return_value = fieldInsertWord(game_play_field, board_kernels,
+                                     field_move.row_, field_move.column_,
+                                     field_move.orientation_,
+                                     field_move.word_,
+                                     (int)strlen(field_move.word_),
+                                     &tournament_board->letter_table_,
+                                     &points_won);
+    if(return_value == OUT_MEMORY_ERROR)
+      break;
+    if(return_value == SUCCESS)
+    {
+      field_move.points_ = points_won;
+      return_value = addArchiveMove(archive_game, &field_move, player_turn);
+      if(return_value == OUT_MEMORY_ERROR)
+        break;
+      pass_count = 0;
+      tournament_game->move_count_++;
+      if(player_turn == player_1)
+        player1_points += points_won;
+      else
+        player2_points += points_won;
+      publishMoveDelta(&tournament->delta_stream_, &delta_game,
+                       game_play_field, board_kernels, field_move.row_,
+                       field_move.column_, field_move.orientation_,
+                       (int)strlen(field_move.word_), player1_points,
+                       player2_points, player_turn);
+    }
+    else
+      pass_count++;
+    return_value = SUCCESS;
+    player_turn = (player_turn == player_1) ? player_2 : player_1;
+  }
+  publishGameEndDelta(&tournament->delta_stream_, &delta_game,
+                      player1_points, player2_points);
+  tournament_game->first_points_ = player1_points;
+  tournament_game->second_points_ = player2_points;
+  archive_game->player1_points_ = player1_points;
+  archive_game->player2_points_ = player2_points;
+  board_kernels->free_field_(game_play_field, field_size);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function writeTournamentGame, we append the result of a game to
+/// the result file, as a CSV line, a JSON line for a ".json" file or with
+/// all its moves for a ".archive" file.
+///
+/// @param tournament the tournament.
+/// @param game_index the finished game.
+/// @param archive_game the moves of the game.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return CANNOT_OPEN_CONFIG_FILE if the archive cannot be written.
+/// @return SUCCESS otherwise.
+//
+int writeTournamentGame(Tournament* tournament, int game_index,
+                        const ArchiveGame* archive_game)
+{
+  const TournamentGame* tournament_game = &tournament->games_[game_index];
+  const char* first_name =
+      tournament->players_[tournament_game->first_].name_;
+  const char* second_name =
+      tournament->players_[tournament_game->second_].name_;
+  const char* winner_name = "draw";
+  if(tournament_game->first_points_ > tournament_game->second_points_)
+    winner_name = first_name;
+  if(tournament_game->second_points_ > tournament_game->first_points_)
+    winner_name = second_name;
+  const char* config_name =
+      tournament->boards_[tournament_game->board_].config_name_;
+
+  int return_value = SUCCESS;
+  pthread_mutex_lock(&tournament->sink_mutex_);
+  if(tournament->sink_format_ == TOURNAMENT_ARCHIVE)
+    return_value = appendArchiveGame(&tournament->archive_writer_,
+                                     archive_game);
+  else if(tournament->sink_format_ == TOURNAMENT_JSON)
+    fprintf(tournament->sink_,
+            "{\"game\":%d,\"config\":\"%s\",\"first\":\"%s\","
+            "\"second\":\"%s\",\"first_points\":%d,\"second_points\":%d,"
+            "\"moves\":%d,\"winner\":\"%s\"}\n",
+            game_index, config_name, first_name, second_name,
+            tournament_game->first_points_, tournament_game->second_points_,
+            tournament_game->move_count_, winner_name);
+  else
+    fprintf(tournament->sink_, "%d,%s,%s,%s,%d,%d,%d,%s\n", game_index,
+            config_name, first_name, second_name,
+            tournament_game->first_points_, tournament_game->second_points_,
+            tournament_game->move_count_, winner_name);
+  if(tournament->sink_ != NULL)
+    fflush(tournament->sink_);
+  pthread_mutex_unlock(&tournament->sink_mutex_);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function tournamentThread, we play the next open game until all
+/// games are played or one of the threads failed.
+///
+/// @param tournament_argument the tournament.
+///
+/// @return NULL
+//
+void* tournamentThread(void* tournament_argument)
+{
+  Tournament* tournament = (Tournament*)tournament_argument;
+  ArchiveGame archive_game;
+  memset(&archive_game, 0, sizeof(ArchiveGame));
+  while(atomic_load(&tournament->error_) == SUCCESS)
+  {
+    int game_index = atomic_fetch_add(&tournament->next_game_, 1);
+    if(game_index >= tournament->game_count_)
+      break;
+    int return_value = playTournamentGame(tournament, game_index,
+                                          &archive_game);
+    if(return_value == SUCCESS)
+      return_value = writeTournamentGame(tournament, game_index,
+                                         &archive_game);
+    if(return_value != SUCCESS)
+    {
+      atomic_store(&tournament->error_, return_value);
+      break;
+    }
+  }
+  free(archive_game.moves_);
+  free(archive_game.move_players_);
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function computeTournamentRatings, we fit Elo ratings to the
+/// results with the Bradley-Terry model, a draw counting half. Every pair
+/// gets one extra draw, so a player who won every game still has a finite
+/// rating. The interval is 1.96 standard errors of the fit.
+///
+/// @param tournament the tournament after its games.
+/// @param ratings receives the rating of every player, 0 on average.
+/// @param intervals receives the half width of the 95% interval.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int computeTournamentRatings(const Tournament* tournament, double* ratings,
+                             double* intervals)
+{
+  double draw_score = 0.5;
+  double interval_z = 1.96;
+  double elo_scale = 400.0;
+  int player_count = tournament->player_count_;
+  double* pair_games =
+      (double*)calloc(player_count * player_count, sizeof(double));
+  double* pair_scores =
+      (double*)calloc(player_count * player_count, sizeof(double));
+  double* strengths = (double*)malloc(player_count * sizeof(double));
+  if((pair_games == NULL) || (pair_scores == NULL) || (strengths == NULL))
+  {
+    free(pair_games);
+    free(pair_scores);
+    free(strengths);
+    return OUT_MEMORY_ERROR;
+  }
+
+  int first = 0;
+  int second = 0;
+  for(first = 0; first < player_count; first++)
+    for(second = 0; second < player_count; second++)
+      if(first != second)
+      {
+        pair_games[first * player_count + second] = 1;
+        pair_scores[first * player_count + second] = draw_score;
+      }
+  int game_iterator = 0;
+  for(game_iterator = 0; game_iterator < tournament->game_count_;
+      game_iterator++)
+  {
+    const TournamentGame* tournament_game =
+        &tournament->games_[game_iterator];
+    first = tournament_game->first_;
+    second = tournament_game->second_;
+    double first_score = draw_score;
+    if(tournament_game->first_points_ > tournament_game->second_points_)
+      first_score = 1;
+    if(tournament_game->first_points_ < tournament_game->second_points_)
+      first_score = 0;
+    pair_games[first * player_count + second]++;
+    pair_games[second * player_count + first]++;
+    pair_scores[first * player_count + second] += first_score;
+    pair_scores[second * player_count + first] += 1 - first_score;
+  }
+
+  // minorization-maximization steps, scaled to a geometric mean of 1
+  for(first = 0; first < player_count; first++)
+    strengths[first] = 1;
+  int round_iterator = 0;
+  for(round_iterator = 0; round_iterator < TOURNAMENT_RATING_ROUNDS;
+      round_iterator++)
+  {
+    double log_sum = 0;
+    for(first = 0; first < player_count; first++)
+    {
+      double score_sum = 0;
+      double weight_sum = 0;
+      for(second = 0; second < player_count; second++)
+      {
+        if(first == second)
+          continue;
+        score_sum += pair_scores[first * player_count + second];
+        weight_sum += pair_games[first * player_count + second] /
+                      (strengths[first] + strengths[second]);
+      }
+      strengths[first] = score_sum / weight_sum;
+      log_sum += log(strengths[first]);
+    }
+    double mean_strength = exp(log_sum / player_count);
+    for(first = 0; first < player_count; first++)
+      strengths[first] /= mean_strength;
+  }
+
+  double rating_slope = log(10.0) / elo_scale;
+  for(first = 0; first < player_count; first++)
+  {
+    ratings[first] = elo_scale * log10(strengths[first]);
+    double information = 0;
+    for(second = 0; second < player_count; second++)
+    {
+      if(first == second)
+        continue;
+      double expected = strengths[first] /
+                        (strengths[first] + strengths[second]);
+      information += pair_games[first * player_count + second] * expected *
+                     (1 - expected);
+    }
+    intervals[first] = interval_z /
+                       (rating_slope * sqrt(information));
+  }
+  free(pair_games);
+  free(pair_scores);
+  free(strengths);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printTournamentStandings, we print the rating, results
+/// and average points margin of every player.
+///
+/// @param tournament the tournament after its games.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int printTournamentStandings(const Tournament* tournament)
+{
+  int player_count = tournament->player_count_;
+  double* ratings = (double*)malloc(player_count * sizeof(double));
+  double* intervals = (double*)malloc(player_count * sizeof(double));
+  if((ratings == NULL) || (intervals == NULL) ||
+     (computeTournamentRatings(tournament, ratings, intervals) != SUCCESS))
+  {
+    free(ratings);
+    free(intervals);
+    return OUT_MEMORY_ERROR;
+  }
+
+  printf("%-16s %8s %7s %6s %6s %6s %6s %8s\n", "Player", "Elo", "95%",
+         "Games", "Wins", "Losses", "Draws", "Margin");
+  int player_iterator = 0;
+  for(player_iterator = 0; player_iterator < player_count; player_iterator++)
+  {
+    int games = 0;
+    int wins = 0;
+    int losses = 0;
+    long margin_sum = 0;
+    int game_iterator = 0;
+    for(game_iterator = 0; game_iterator < tournament->game_count_;
+        game_iterator++)
+    {
+      const TournamentGame* tournament_game =
+          &tournament->games_[game_iterator];
+      int margin = tournament_game->first_points_ -
+                   tournament_game->second_points_;
+      if(tournament_game->second_ == player_iterator)
+        margin = -margin;
+      else if(tournament_game->first_ != player_iterator)
+        continue;
+      games++;
+      margin_sum += margin;
+      if(margin > 0)
+        wins++;
+      if(margin < 0)
+        losses++;
+    }
+    double average_margin = 0;
+    if(games > 0)
+      average_margin = (double)margin_sum / games;
+    printf("%-16s %+8.1f %7.1f %6d %6d %6d %6d %+8.2f\n",
+           tournament->players_[player_iterator].name_,
+           ratings[player_iterator], intervals[player_iterator], games, wins,
+           losses, games - wins - losses, average_margin);
+  }
+  free(ratings);
+  free(intervals);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function runTournament, we play every ordered pair of players on
+/// every config, so each player starts once against each other player, on
+/// one thread per processor. Results are streamed to the result file as
+/// the games end and the ratings are printed at the end. The moves of all
+/// games are published to the delta stream next to the result file, the
+/// result name with DELTA_STREAM_SUFFIX, for viewers to watch.
+///
+/// @param result_name name of the result file, JSON lines for ".json".
+/// @param player_specs the players, separated by commas.
+/// @param config_names names of the config files.
+/// @param config_count the number of config files.
+///
+/// @return WRONG_ARGUMENTS_NR if there are not two valid players.
+/// @return CANNOT_OPEN_CONFIG_FILE if a file cannot be opened.
+/// @return INVALID_CONFIG_FILE if a config file is not valid.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int runTournament(char* result_name, char* player_specs, char** config_names,
+                  int config_count)
+{
+  int json_suffix_size = 5;
+  int archive_suffix_size = 8;
+  Tournament tournament;
+  memset(&tournament, 0, sizeof(Tournament));
+  int return_value = parseTournamentPlayers(player_specs,
+                                            &tournament.players_,
+                                            &tournament.player_count_);
+  if((return_value == SUCCESS) && (tournament.player_count_ < 2))
+  {
+    printf("Error: A tournament needs two players!\n");
+    return_value = WRONG_ARGUMENTS_NR;
+  }
+  if(return_value == SUCCESS)
+  {
+    return_value = loadDictionary(DICTIONARY_NAME, &tournament.dictionary_);
+    if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Cannot open file: %s\n", DICTIONARY_NAME);
+  }
+  // the book is only opened for players asking for it
+  int book_players = 0;
+  int player_iterator = 0;
+  for(player_iterator = 0;
+      (return_value == SUCCESS) && (player_iterator < tournament.player_count_);
+      player_iterator++)
+    book_players += tournament.players_[player_iterator].book_;
+  if((return_value == SUCCESS) && (book_players > 0))
+  {
+    return_value = openOpeningBook(OPENING_BOOK_NAME,
+                                   &tournament.opening_book_);
+    if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Cannot open file: %s\n", OPENING_BOOK_NAME);
+    if(return_value == INVALID_CONFIG_FILE)
+      printf("Error: Invalid file: %s\n", OPENING_BOOK_NAME);
+  }
+  if(return_value == SUCCESS)
+  {
+    tournament.boards_ = (TournamentBoard*)calloc(config_count,
+                                                  sizeof(TournamentBoard));
+    if(tournament.boards_ == NULL)
+      return_value = OUT_MEMORY_ERROR;
+  }
+  int config_iterator = 0;
+  for(config_iterator = 0;
+      (return_value == SUCCESS) && (config_iterator < config_count);
+      config_iterator++)
+  {
+    return_value = loadTournamentBoard(config_names[config_iterator],
+                                       &tournament.boards_[config_iterator]);
+    tournament.board_count_++;
+  }
+
+  int pair_count = tournament.player_count_ * (tournament.player_count_ - 1);
+  if(return_value == SUCCESS)
+  {
+    tournament.game_count_ = config_count * pair_count;
+    tournament.games_ = (TournamentGame*)calloc(tournament.game_count_,
+                                                sizeof(TournamentGame));
+    if(tournament.games_ == NULL)
+      return_value = OUT_MEMORY_ERROR;
+  }
+  int game_iterator = 0;
+  for(game_iterator = 0;
+      (return_value == SUCCESS) && (game_iterator < tournament.game_count_);
+      game_iterator++)
+  {
+    TournamentGame* tournament_game = &tournament.games_[game_iterator];
+    int pair_index = game_iterator % pair_count;
+    tournament_game->board_ = game_iterator / pair_count;
+    tournament_game->first_ = pair_index / (tournament.player_count_ - 1);
+    tournament_game->second_ = pair_index % (tournament.player_count_ - 1);
+    if(tournament_game->second_ >= tournament_game->first_)
+      tournament_game->second_++;
+  }
+
+  size_t result_name_size = strlen(result_name);
+  char* stream_name = NULL;
+  if(return_value == SUCCESS)
+  {
+    stream_name = (char*)malloc(result_name_size +
+                                sizeof(DELTA_STREAM_SUFFIX));
+    if(stream_name == NULL)
+      return_value = OUT_MEMORY_ERROR;
+  }
+  if(return_value == SUCCESS)
+  {
+    int max_field_size = 0;
+    for(config_iterator = 0; config_iterator < tournament.board_count_;
+        config_iterator++)
+      if(tournament.boards_[config_iterator].board_kernels_.field_size_ >
+         max_field_size)
+        max_field_size =
+            tournament.boards_[config_iterator].board_kernels_.field_size_;
+    strcpy(stream_name, result_name);
+    strcat(stream_name, DELTA_STREAM_SUFFIX);
+    return_value = createDeltaStream(stream_name, max_field_size,
+                                     &tournament.delta_stream_);
+    if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Cannot open file: %s\n", stream_name);
+  }
+  free(stream_name);
+  tournament.sink_format_ = TOURNAMENT_CSV;
+  if((result_name_size >= (size_t)json_suffix_size) &&
+     (strcmp(result_name + result_name_size - json_suffix_size, ".json") ==
+      0))
+    tournament.sink_format_ = TOURNAMENT_JSON;
+  if((result_name_size >= (size_t)archive_suffix_size) &&
+     (strcmp(result_name + result_name_size - archive_suffix_size,
+             ".archive") == 0))
+    tournament.sink_format_ = TOURNAMENT_ARCHIVE;
+  if((return_value == SUCCESS) &&
+     (tournament.sink_format_ == TOURNAMENT_ARCHIVE))
+  {
+    // games are added to an archive which exists already
+    return_value = openArchiveWriter(result_name,
+                                     &tournament.archive_writer_);
+    if(return_value == INVALID_CONFIG_FILE)
+      printf("Error: Invalid file: %s\n", result_name);
+    if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Cannot open file: %s\n", result_name);
+  }
+  else if(return_value == SUCCESS)
+  {
+    tournament.sink_ = fopen(result_name, "w");
+    if(tournament.sink_ == NULL)
+    {
+      printf("Error: Cannot open file: %s\n", result_name);
+      return_value = CANNOT_OPEN_CONFIG_FILE;
+    }
+  }
+  if(return_value == SUCCESS)
+  {
+    if(tournament.sink_format_ == TOURNAMENT_CSV)
+      fprintf(tournament.sink_, "game,config,first,second,first_points,"
+              "second_points,moves,winner\n");
+    pthread_mutex_init(&tournament.sink_mutex_, NULL);
+    atomic_init(&tournament.next_game_, 0);
+    atomic_init(&tournament.error_, SUCCESS);
+
+    long thread_count = sysconf(_SC_NPROCESSORS_ONLN);
+    if(thread_count > tournament.game_count_)
+      thread_count = tournament.game_count_;
+    if(thread_count < 1)
+      thread_count = 1;
+    pthread_t* threads = (pthread_t*)malloc(thread_count * sizeof(pthread_t));
+    if(threads == NULL)
+      return_value = OUT_MEMORY_ERROR;
+    long started_threads = 0;
+    while((threads != NULL) && (started_threads < thread_count) &&
+          (pthread_create(&threads[started_threads], NULL, tournamentThread,
+                          &tournament) == 0))
+      started_threads++;
+    // with no thread at all the games are played here
+    if((threads != NULL) && (started_threads == 0))
+      tournamentThread(&tournament);
+    long thread_iterator = 0;
+    for(thread_iterator = 0; thread_iterator < started_threads;
+        thread_iterator++)
+      pthread_join(threads[thread_iterator], NULL);
+    free(threads);
+    pthread_mutex_destroy(&tournament.sink_mutex_);
+    if(tournament.sink_ != NULL)
+      fclose(tournament.sink_);
+    int close_value = closeArchiveWriter(&tournament.archive_writer_);
+    if(return_value == SUCCESS)
+      return_value = atomic_load(&tournament.error_);
+    if(return_value == SUCCESS)
+      return_value = close_value;
+    if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Could not save to file!\n");
+    if(return_value == SUCCESS)
+      return_value = printTournamentStandings(&tournament);
+  }
+  if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+
+  closeDeltaStream(&tournament.delta_stream_);
+  for(config_iterator = 0; config_iterator < tournament.board_count_;
+      config_iterator++)
+  {
+    free(tournament.boards_[config_iterator].packed_);
+    free(tournament.boards_[config_iterator].char_points_string_);
+  }
+  free(tournament.boards_);
+  free(tournament.games_);
+  free(tournament.players_);
+  freeDictionary(&tournament.dictionary_);
+  closeOpeningBook(&tournament.opening_book_);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function switchOutput, we point the standard output at another
+/// stream, after writing out what is buffered for the current one. The C
+/// library of the system lets stdout be set like any other variable.
+///
+/// @param output the stream to print to from now on.
+///
+/// @return
+//
+void switchOutput(FILE* output)
+{
+  fflush(stdout);
+  stdout = output;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function beginSessionOutput, we point the standard output at the
+/// output buffer of a session, which is opened if everything before was
+/// sent already.
+///
+/// @param served_session the session about to run.
+///
+/// @return OUT_MEMORY_ERROR if the buffer could not be opened.
+/// @return SUCCESS otherwise.
+//
+int beginSessionOutput(ServedSession* served_session)
+{
+  if(served_session->output_ == NULL)
+  {
+    served_session->output_ = open_memstream(&served_session->output_buffer_,
+                                             &served_session->output_size_);
+    served_session->output_sent_ = 0;
+  }
+  if(served_session->output_ == NULL)
+    return OUT_MEMORY_ERROR;
+  switchOutput(served_session->output_);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function sendSessionOutput, we write as much of the output buffer
+/// of a session to its connection as it takes without blocking. A buffer
+/// which was sent completely is closed.
+///
+/// @param served_session the session.
+///
+/// @return error_return_value if the connection failed.
+/// @return SUCCESS otherwise.
+//
+int sendSessionOutput(ServedSession* served_session)
+{
+  int error_return_value = 1;
+  if(served_session->output_ == NULL)
+    return SUCCESS;
+  fflush(served_session->output_);
+  while(served_session->output_sent_ < served_session->output_size_)
+  {
+    ssize_t sent_size = write(served_session->socket_,
+                              served_session->output_buffer_ +
+                                  served_session->output_sent_,
+                              served_session->output_size_ -
+                                  served_session->output_sent_);
+    if((sent_size < 0) && (errno == EINTR))
+      continue;
+    if((sent_size < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+      return SUCCESS;
+    if(sent_size < 0)
+      return error_return_value;
+    served_session->output_sent_ += (size_t)sent_size;
+  }
+  fclose(served_session->output_);
+  free(served_session->output_buffer_);
+  served_session->output_ = NULL;
+  served_session->output_buffer_ = NULL;
+  served_session->output_size_ = 0;
+  served_session->output_sent_ = 0;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function closeServedSession, we close the connection of a
+/// session and free it.
+///
+/// @param served_session the session, its game ended already.
+///
+/// @return
+//
+void closeServedSession(ServedSession* served_session)
+{
+  if(served_session->output_ != NULL)
+  {
+    fclose(served_session->output_);
+    free(served_session->output_buffer_);
+  }
+  close(served_session->socket_);
+  free(served_session->game_session_.line_);
+  free(served_session);
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function openServedSession, we start the game of a new
+/// connection and print its field and first prompt to its output buffer.
+///
+/// @param client_socket the connection, not blocking.
+/// @param config_name name of the config file of the game.
+/// @param dictionary the dictionary all games share.
+/// @param console_output the console output of the server.
+///
+/// @return NULL if the game could not be started, the connection is closed.
+/// @return served_session otherwise.
+//
+ServedSession* openServedSession(int client_socket, char* config_name,
+                                 const Dictionary* dictionary,
+                                 FILE* console_output)
+{
+  ServedSession* served_session =
+      (ServedSession*)calloc(1, sizeof(ServedSession));
+  if(served_session == NULL)
+  {
+    close(client_socket);
+    return NULL;
+  }
+  served_session->socket_ = client_socket;
+  if(beginSessionOutput(served_session) != SUCCESS)
+  {
+    closeServedSession(served_session);
+    return NULL;
+  }
+  int return_value = loadGameState(config_name, &served_session->game_state_,
+                                   dictionary);
+  if(return_value == SUCCESS)
+  {
+    initializeGameSession(&served_session->game_session_,
+                          &served_session->game_state_, NULL, NULL);
+    // every game started from the same config file, which is not theirs
+    // to overwrite, and a save would start a writer thread per session
+    served_session->game_session_.save_refused_ = 1;
+    gameSessionPrompt(&served_session->game_session_);
+  }
+  switchOutput(console_output);
+  // the error of a game which could not be started is sent once at most
+  if((sendSessionOutput(served_session) != SUCCESS) ||
+     (return_value != SUCCESS))
+  {
+    closeServedSession(served_session);
+    return NULL;
+  }
+  return served_session;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function serveSession, we handle the events of a connection.
+/// Input is only read while all output of the session was sent, so a
+/// client which does not read blocks nothing but its own session. A
+/// finished session is freed and its connection closed once its last
+/// output was sent.
+///
+/// @param served_session the session with an event.
+/// @param session_events the epoll events of the connection.
+/// @param event_queue the epoll queue of the server.
+/// @param console_output the console output of the server.
+///
+/// @return 1 if the session was closed.
+/// @return 0 otherwise.
+//
+int serveSession(ServedSession* served_session, unsigned int session_events,
+                 int event_queue, FILE* console_output)
+{
+  GameSession* game_session = &served_session->game_session_;
+  int session_failed = 0;
+  if((served_session->output_ == NULL) && (game_session->running_) &&
+     (session_events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+  {
+    char input[SESSION_READ_SIZE];
+    ssize_t input_size = read(served_session->socket_, input,
+                              SESSION_READ_SIZE);
+    if((input_size >= 0) ||
+       ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)))
+    {
+      if(beginSessionOutput(served_session) != SUCCESS)
+        session_failed = 1;
+      else if(input_size > 0)
+        feedGameSession(game_session, input, (int)input_size);
+      else
+        endGameSessionInput(game_session);
+      if((!session_failed) && (!game_session->running_))
+      {
+        if(freeGameState(&served_session->game_state_) ==
+           CANNOT_OPEN_CONFIG_FILE)
+          printf("Error: Could not save to file!\n");
+        if(game_session->memory_error_ == OUT_MEMORY_ERROR)
+          printf("Error: Out of memory\n");
+      }
+      switchOutput(console_output);
+    }
+  }
+  if(sendSessionOutput(served_session) != SUCCESS)
+    session_failed = 1;
+
+  if((session_failed) ||
+     ((!game_session->running_) && (served_session->output_ == NULL)))
+  {
+    if((session_failed) && (game_session->running_))
+      freeGameState(&served_session->game_state_);
+    closeServedSession(served_session);
+    return 1;
+  }
+  struct epoll_event session_event;
+  session_event.events = EPOLLIN;
+  if(served_session->output_ != NULL)
+    session_event.events = EPOLLOUT;
+  session_event.data.ptr = served_session;
+  epoll_ctl(event_queue, EPOLL_CTL_MOD, served_session->socket_,
+            &session_event);
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function runSessionServer, we serve text games over TCP on the
+/// local host from one thread. Every connection plays its own game of the
+/// config file, which the games cannot save to. A session only runs when
+/// input arrives, so an idle game costs its state and a socket but no
+/// thread. The standard output points at the output buffer of a session
+/// while it runs, which is why there is only one scheduler thread.
+/// Connections never block, buffered output is sent when epoll reports the
+/// connection writable. The moves of all games are published to the delta
+/// stream "<configfile>.deltas", numbered by connection.
+///
+/// @param port_text the port to listen on.
+/// @param config_name name of the config file of every game.
+/// @param session_limit the number of connections to serve, 0 for no end.
+///
+/// @return WRONG_ARGUMENTS_NR if the port is not valid.
+/// @return CANNOT_OPEN_CONFIG_FILE if the port cannot be opened.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int runSessionServer(char* port_text, char* config_name, int session_limit)
+{
+  int max_port = 65535;
+  int socket_option = 1;
+  int port = atoi(port_text);
+  if((port < 1) || (port > max_port))
+  {
+    printf("Error: Invalid port: %s\n", port_text);
+    return WRONG_ARGUMENTS_NR;
+  }
+  char* stream_name = (char*)malloc(strlen(config_name) +
+                                    sizeof(DELTA_STREAM_SUFFIX));
+  if(stream_name == NULL)
+  {
+    printf("Error: Out of memory\n");
+    return OUT_MEMORY_ERROR;
+  }
+  strcpy(stream_name, config_name);
+  strcat(stream_name, DELTA_STREAM_SUFFIX);
+  // loaded once for all games, without it every lookup misses
+  Dictionary dictionary;
+  if(loadDictionary(DICTIONARY_NAME, &dictionary) == OUT_MEMORY_ERROR)
+  {
+    free(stream_name);
+    printf("Error: Out of memory\n");
+    return OUT_MEMORY_ERROR;
+  }
+
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons((unsigned short)port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  int listen_socket = socket(AF_INET, SOCK_STREAM, 0);
+  int event_queue = epoll_create1(0);
+  struct epoll_event listen_event;
+  listen_event.events = EPOLLIN;
+  listen_event.data.ptr = NULL;
+  if((listen_socket < 0) || (event_queue < 0) ||
+     (setsockopt(listen_socket, SOL_SOCKET, SO_REUSEADDR, &socket_option,
+                 sizeof(socket_option)) != 0) ||
+     (bind(listen_socket, (struct sockaddr*)&address, sizeof(address)) != 0) ||
+     (listen(listen_socket, SOMAXCONN) != 0) ||
+     (fcntl(listen_socket, F_SETFL, O_NONBLOCK) != 0) ||
+     (epoll_ctl(event_queue, EPOLL_CTL_ADD, listen_socket,
+                &listen_event) != 0))
+  {
+    printf("Error: Cannot open port: %d\n", port);
+    if(listen_socket >= 0)
+      close(listen_socket);
+    if(event_queue >= 0)
+      close(event_queue);
+    freeDictionary(&dictionary);
+    free(stream_name);
+    return CANNOT_OPEN_CONFIG_FILE;
+  }
+  // a client which left must not end the server when it gets output
+  signal(SIGPIPE, SIG_IGN);
+  printf("Serving %s on port %d.\n", config_name, port);
+  fflush(stdout);
+  FILE* console_output = stdout;
+  DeltaStream delta_stream;
+  memset(&delta_stream, 0, sizeof(DeltaStream));
+
+  int accepted_sessions = 0;
+  int open_sessions = 0;
+  while((listen_socket >= 0) || (open_sessions > 0))
+  {
+    struct epoll_event events[SESSION_EVENTS];
+    int event_count = epoll_wait(event_queue, events, SESSION_EVENTS, -1);
+    if((event_count < 0) && (errno == EINTR))
+      continue;
+    if(event_count < 0)
+      break;
+    int event_iterator = 0;
+    for(event_iterator = 0; event_iterator < event_count; event_iterator++)
+    {
+      ServedSession* served_session =
+          (ServedSession*)events[event_iterator].data.ptr;
+      if(served_session != NULL)
+      {
+        open_sessions -= serveSession(served_session,
+                                      events[event_iterator].events,
+                                      event_queue, console_output);
+        continue;
+      }
+      int client_socket = -1;
+      while((listen_socket >= 0) &&
+            ((client_socket = accept(listen_socket, NULL, NULL)) >= 0))
+      {
+        accepted_sessions++;
+        if(accepted_sessions == session_limit)
+        {
+          close(listen_socket);
+          listen_socket = -1;
+        }
+        if(fcntl(client_socket, F_SETFL, O_NONBLOCK) != 0)
+        {
+          close(client_socket);
+          continue;
+        }
+        served_session = openServedSession(client_socket, config_name,
+                                           &dictionary, console_output);
+        if(served_session == NULL)
+          continue;
+        // the stream is sized for the field of the first game
+        if((delta_stream.header_ == NULL) && (stream_name != NULL) &&
+           (createDeltaStream(
+                stream_name,
+                served_session->game_state_.board_kernels_.field_size_,
+                &delta_stream) != SUCCESS))
+        {
+          printf("Error: Cannot open file: %s\n", stream_name);
+          fflush(stdout);
+          free(stream_name);
+          stream_name = NULL;
+        }
+        if(delta_stream.header_ != NULL)
+          publishGameState(&served_session->game_state_, &delta_stream,
+                           (unsigned int)accepted_sessions);
+        // the field and first prompt may still wait for the connection
+        struct epoll_event session_event;
+        session_event.events = EPOLLIN;
+        if(served_session->output_ != NULL)
+          session_event.events = EPOLLOUT;
+        session_event.data.ptr = served_session;
+        if(epoll_ctl(event_queue, EPOLL_CTL_ADD, client_socket,
+                     &session_event) != 0)
+        {
+          freeGameState(&served_session->game_state_);
+          closeServedSession(served_session);
+          continue;
+        }
+        open_sessions++;
+      }
+    }
+  }
+  close(event_queue);
+  closeDeltaStream(&delta_stream);
+  free(stream_name);
+  freeDictionary(&dictionary);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function dictionaryImageLayout, we place the arrays of a
+/// dictionary in its image, each at a multiple of DICTIONARY_IMAGE_ALIGN.
+///
+/// @param dictionary the dictionary, only its counts are used.
+/// @param section_offsets receives the offset of every array.
+///
+/// @return image_size the number of bytes of the image.
+//
+size_t dictionaryImageLayout(const Dictionary* dictionary,
+                             size_t* section_offsets)
+{
+  size_t section_sizes[DICTIONARY_IMAGE_SECTIONS];
+  section_sizes[0] = dictionary->node_count_ * sizeof(DictionaryNode);
+  section_sizes[1] = (dictionary->max_word_size_ * ALPHABET_SIZE + 1) *
+                     sizeof(int);
+  section_sizes[2] = dictionary->node_count_ * sizeof(int);
+  section_sizes[3] = dictionary->word_count_ * sizeof(int);
+  section_sizes[4] = (dictionary->anagram_class_count_ + 1) * sizeof(int);
+  section_sizes[5] = dictionary->anagram_slot_count_ * sizeof(int);
+  section_sizes[6] = (dictionary->anagram_class_count_ + 1) *
+                     sizeof(unsigned long long);
+  size_t image_size = DICTIONARY_IMAGE_HEADER_SIZE;
+  int section_iterator = 0;
+  for(section_iterator = 0; section_iterator < DICTIONARY_IMAGE_SECTIONS;
+      section_iterator++)
+  {
+    section_offsets[section_iterator] = image_size;
+    image_size += (section_sizes[section_iterator] +
+                   DICTIONARY_IMAGE_ALIGN - 1) &
+                  ~(size_t)(DICTIONARY_IMAGE_ALIGN - 1);
+  }
+  return image_size;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function dictionaryImageName, we name the image of a word list
+/// by appending DICTIONARY_IMAGE_SUFFIX.
+///
+/// @param word_list_name name of the word list.
+///
+/// @return NULL if the memory could not be allocated.
+/// @return image_name otherwise, to be freed by the caller.
+//
+char* dictionaryImageName(const char* word_list_name)
+{
+  char* image_name = (char*)malloc(strlen(word_list_name) +
+                                   sizeof(DICTIONARY_IMAGE_SUFFIX));
+  if(image_name == NULL)
+    return NULL;
+  strcpy(image_name, word_list_name);
+  strcat(image_name, DICTIONARY_IMAGE_SUFFIX);
+  return image_name;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function openDictionaryImage, we map the image of a word list
+/// read only and point the dictionary into it. The image is only used
+/// while the word list has the size and change time it was built from.
+///
+/// @param word_list_name name of the word list.
+/// @param dictionary receives the dictionary, empty if there is no image.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if there is no image to map.
+/// @return INVALID_CONFIG_FILE if the image is not one of the word list.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int openDictionaryImage(const char* word_list_name, Dictionary* dictionary)
+{
+  int value_bits = 32;
+  unsigned long long nanoseconds = 1000000000ULL;
+  memset(dictionary, 0, sizeof(Dictionary));
+  struct stat word_list_stat;
+  if(stat(word_list_name, &word_list_stat) != 0)
+    return CANNOT_OPEN_CONFIG_FILE;
+  char* image_name = dictionaryImageName(word_list_name);
+  if(image_name == NULL)
+    return OUT_MEMORY_ERROR;
+  int image_file = open(image_name, O_RDONLY);
+  free(image_name);
+  if(image_file < 0)
+    return CANNOT_OPEN_CONFIG_FILE;
+  struct stat image_stat;
+  if((fstat(image_file, &image_stat) != 0) ||
+     (image_stat.st_size < DICTIONARY_IMAGE_HEADER_SIZE))
+  {
+    close(image_file);
+    return INVALID_CONFIG_FILE;
+  }
+  size_t map_size = (size_t)image_stat.st_size;
+  void* image_map = mmap(NULL, map_size, PROT_READ, MAP_SHARED, image_file,
+                         0);
+  close(image_file);
+  if(image_map == MAP_FAILED)
+    return CANNOT_OPEN_CONFIG_FILE;
+
+  const unsigned char* image = (const unsigned char*)image_map;
+  unsigned long long word_list_size =
+      getDeltaValue(image + 32, 4) |
+      ((unsigned long long)getDeltaValue(image + 36, 4) << value_bits);
+  unsigned long long word_list_time =
+      getDeltaValue(image + 40, 4) |
+      ((unsigned long long)getDeltaValue(image + 44, 4) << value_bits);
+  unsigned long long change_time =
+      (unsigned long long)word_list_stat.st_mtim.tv_sec * nanoseconds +
+      (unsigned long long)word_list_stat.st_mtim.tv_nsec;
+  dictionary->node_count_ = (int)getDeltaValue(image + 12, 4);
+  dictionary->word_count_ = (int)getDeltaValue(image + 16, 4);
+  dictionary->max_word_size_ = (int)getDeltaValue(image + 20, 4);
+  dictionary->anagram_class_count_ = (int)getDeltaValue(image + 24, 4);
+  dictionary->anagram_slot_count_ = (int)getDeltaValue(image + 28, 4);
+  size_t section_offsets[DICTIONARY_IMAGE_SECTIONS];
+  if((memcmp(image, DICTIONARY_IMAGE_MAGIC, DICTIONARY_IMAGE_MAGIC_SIZE) !=
+      0) ||
+     (getDeltaValue(image + DICTIONARY_IMAGE_MAGIC_SIZE, 4) !=
+      sizeof(DictionaryNode)) ||
+     (word_list_size != (unsigned long long)word_list_stat.st_size) ||
+     (word_list_time != change_time) ||
+     (dictionary->node_count_ < 1) || (dictionary->word_count_ < 0) ||
+     (dictionary->max_word_size_ < 0) ||
+     (dictionary->max_word_size_ >= MOVE_WORD_SIZE) ||
+     (dictionary->anagram_class_count_ < 0) ||
+     (dictionary->anagram_slot_count_ < 1) ||
+     (dictionary->anagram_slot_count_ &
+      (dictionary->anagram_slot_count_ - 1)) ||
+     (dictionaryImageLayout(dictionary, section_offsets) != map_size))
+  {
+    munmap(image_map, map_size);
+    memset(dictionary, 0, sizeof(Dictionary));
+    return INVALID_CONFIG_FILE;
+  }
+
+  // the searches only read the arrays, so they can point into the map
+  unsigned char* sections = (unsigned char*)image_map;
+  dictionary->nodes_ = (DictionaryNode*)(sections + section_offsets[0]);
+  dictionary->anchor_offsets_ = (int*)(sections + section_offsets[1]);
+  dictionary->anchor_nodes_ = (int*)(sections + section_offsets[2]);
+  dictionary->anagram_nodes_ = (int*)(sections + section_offsets[3]);
+  dictionary->anagram_offsets_ = (int*)(sections + section_offsets[4]);
+  dictionary->anagram_slots_ = (int*)(sections + section_offsets[5]);
+  dictionary->anagram_keys_ =
+      (unsigned long long*)(sections + section_offsets[6]);
+  int return_value = checkDictionaryImage(dictionary);
+  if(return_value != SUCCESS)
+  {
+    munmap(image_map, map_size);
+    memset(dictionary, 0, sizeof(Dictionary));
+    return return_value;
+  }
+  dictionary->image_ = image;
+  dictionary->image_size_ = map_size;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function checkDictionaryImage, we check every index of a mapped
+/// dictionary once, so a damaged image is refused instead of sending the
+/// searches outside of the map. Children have to come after their parent
+/// and point back to it with the letter of their bit, so the trie has no
+/// cycles and no word is longer than the longest word.
+///
+/// @param dictionary the dictionary pointing into the image.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return INVALID_CONFIG_FILE if an index is out of place.
+/// @return SUCCESS otherwise.
+//
+int checkDictionaryImage(const Dictionary* dictionary)
+{
+  int node_count = dictionary->node_count_;
+  int* node_depths = (int*)malloc(node_count * sizeof(int));
+  if(node_depths == NULL)
+    return OUT_MEMORY_ERROR;
+
+  int return_value = SUCCESS;
+  int word_count = 0;
+  node_depths[0] = 0;
+  int node_iterator = 0;
+  for(node_iterator = 0;
+      (return_value == SUCCESS) && (node_iterator < node_count);
+      node_iterator++)
+  {
+    const DictionaryNode* dictionary_node = &dictionary->nodes_[node_iterator];
+    if(node_iterator > 0)
+    {
+      if((dictionary_node->parent_ < 0) ||
+         (dictionary_node->parent_ >= node_iterator) ||
+         (dictionary_node->letter_ >= ALPHABET_SIZE))
+      {
+        return_value = INVALID_CONFIG_FILE;
+        break;
+      }
+      node_depths[node_iterator] = node_depths[dictionary_node->parent_] + 1;
+    }
+    if((node_depths[node_iterator] > dictionary->max_word_size_) ||
+       (dictionary_node->longest_suffix_ > dictionary->max_word_size_) ||
+       (dictionary_node->child_mask_ >= (1u << ALPHABET_SIZE)))
+      return_value = INVALID_CONFIG_FILE;
+    if(dictionary_node->word_end_)
+      word_count++;
+    if(dictionary_node->child_mask_ == 0)
+      continue;
+    int child_count = __builtin_popcount(dictionary_node->child_mask_);
+    if((dictionary_node->first_child_ <= node_iterator) ||
+       (dictionary_node->first_child_ > node_count - child_count))
+    {
+      return_value = INVALID_CONFIG_FILE;
+      break;
+    }
+    int child_index = dictionary_node->first_child_;
+    int letter_iterator = 0;
+    for(letter_iterator = 0; letter_iterator < ALPHABET_SIZE;
+        letter_iterator++)
+    {
+      if(!(dictionary_node->child_mask_ & (1u << letter_iterator)))
+        continue;
+      if((dictionary->nodes_[child_index].parent_ != node_iterator) ||
+         (dictionary->nodes_[child_index].letter_ != letter_iterator))
+        return_value = INVALID_CONFIG_FILE;
+      child_index++;
+    }
+  }
+  if(word_count != dictionary->word_count_)
+    return_value = INVALID_CONFIG_FILE;
+
+  // every node but the root once, in the slot of its depth and letter
+  int anchor_slot_count = dictionary->max_word_size_ * ALPHABET_SIZE;
+  const int* anchor_offsets = dictionary->anchor_offsets_;
+  if((return_value == SUCCESS) &&
+     ((anchor_offsets[0] != 0) ||
+      (anchor_offsets[anchor_slot_count] != node_count - 1)))
+    return_value = INVALID_CONFIG_FILE;
+  int slot_iterator = 0;
+  for(slot_iterator = 0;
+      (return_value == SUCCESS) && (slot_iterator < anchor_slot_count);
+      slot_iterator++)
+  {
+    if(anchor_offsets[slot_iterator] > anchor_offsets[slot_iterator + 1])
+    {
+      return_value = INVALID_CONFIG_FILE;
+      break;
+    }
+    int anchor_iterator = 0;
+    for(anchor_iterator = anchor_offsets[slot_iterator];
+        anchor_iterator < anchor_offsets[slot_iterator + 1];
+        anchor_iterator++)
+    {
+      int anchor_node = dictionary->anchor_nodes_[anchor_iterator];
+      if((anchor_node < 1) || (anchor_node >= node_count) ||
+         ((node_depths[anchor_node] - 1) * ALPHABET_SIZE +
+          dictionary->nodes_[anchor_node].letter_ != slot_iterator))
+        return_value = INVALID_CONFIG_FILE;
+    }
+  }
+
+  // every class a range of word end nodes, found through one slot
+  int class_count = dictionary->anagram_class_count_;
+  const int* anagram_offsets = dictionary->anagram_offsets_;
+  if((return_value == SUCCESS) &&
+     ((anagram_offsets[0] != 0) ||
+      (anagram_offsets[class_count] != dictionary->word_count_)))
+    return_value = INVALID_CONFIG_FILE;
+  int class_iterator = 0;
+  for(class_iterator = 0;
+      (return_value == SUCCESS) && (class_iterator < class_count);
+      class_iterator++)
+    if(anagram_offsets[class_iterator] >= anagram_offsets[class_iterator + 1])
+      return_value = INVALID_CONFIG_FILE;
+  int entry_iterator = 0;
+  for(entry_iterator = 0;
+      (return_value == SUCCESS) && (entry_iterator < dictionary->word_count_);
+      entry_iterator++)
+  {
+    int anagram_node = dictionary->anagram_nodes_[entry_iterator];
+    if((anagram_node < 1) || (anagram_node >= node_count) ||
+       (!dictionary->nodes_[anagram_node].word_end_))
+      return_value = INVALID_CONFIG_FILE;
+  }
+  int used_slots = 0;
+  for(slot_iterator = 0;
+      (return_value == SUCCESS) &&
+      (slot_iterator < dictionary->anagram_slot_count_);
+      slot_iterator++)
+  {
+    int slot_class = dictionary->anagram_slots_[slot_iterator];
+    if((slot_class < 0) || (slot_class > class_count))
+      return_value = INVALID_CONFIG_FILE;
+    if(slot_class != 0)
+      used_slots++;
+  }
+  // a free slot has to be left, it ends every probe
+  if((return_value == SUCCESS) &&
+     ((used_slots != class_count) ||
+      (used_slots >= dictionary->anagram_slot_count_)))
+    return_value = INVALID_CONFIG_FILE;
+  free(node_depths);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function buildDictionaryImage, we build the dictionary of a word
+/// list once and write it as an image next to the list, for every game to
+/// map instead of building it again.
+///
+/// @param word_list_name name of the word list.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if a file cannot be read or written.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int buildDictionaryImage(char* word_list_name)
+{
+  int value_bits = 32;
+  unsigned long long nanoseconds = 1000000000ULL;
+  struct stat word_list_stat;
+  WordList word_list;
+  int return_value = loadWordList(word_list_name, &word_list);
+  if((return_value == SUCCESS) && (stat(word_list_name, &word_list_stat) != 0))
+  {
+    freeWordList(&word_list);
+    return_value = CANNOT_OPEN_CONFIG_FILE;
+  }
+  if(return_value == CANNOT_OPEN_CONFIG_FILE)
+    printf("Error: Cannot open file: %s\n", word_list_name);
+  if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+  if(return_value != SUCCESS)
+    return return_value;
+
+  Dictionary dictionary;
+  return_value = buildDictionary(&word_list, &dictionary);
+  freeWordList(&word_list);
+  size_t section_offsets[DICTIONARY_IMAGE_SECTIONS];
+  size_t image_size = dictionaryImageLayout(&dictionary, section_offsets);
+  unsigned char* image = NULL;
+  char* image_name = dictionaryImageName(word_list_name);
+  if(return_value == SUCCESS)
+    image = (unsigned char*)calloc(image_size, 1);
+  if((image == NULL) || (image_name == NULL))
+    return_value = OUT_MEMORY_ERROR;
+
+  if(return_value == SUCCESS)
+  {
+    unsigned long long word_list_size =
+        (unsigned long long)word_list_stat.st_size;
+    unsigned long long word_list_time =
+        (unsigned long long)word_list_stat.st_mtim.tv_sec * nanoseconds +
+        (unsigned long long)word_list_stat.st_mtim.tv_nsec;
+    memcpy(image, DICTIONARY_IMAGE_MAGIC, DICTIONARY_IMAGE_MAGIC_SIZE);
+    putDeltaValue(image + DICTIONARY_IMAGE_MAGIC_SIZE,
+                  sizeof(DictionaryNode), 4);
+    putDeltaValue(image + 12, dictionary.node_count_, 4);
+    putDeltaValue(image + 16, dictionary.word_count_, 4);
+    putDeltaValue(image + 20, dictionary.max_word_size_, 4);
+    putDeltaValue(image + 24, dictionary.anagram_class_count_, 4);
+    putDeltaValue(image + 28, dictionary.anagram_slot_count_, 4);
+    putDeltaValue(image + 32, (unsigned int)word_list_size, 4);
+    putDeltaValue(image + 36, (unsigned int)(word_list_size >> value_bits),
+                  4);
+    putDeltaValue(image + 40, (unsigned int)word_list_time, 4);
+    putDeltaValue(image + 44, (unsigned int)(word_list_time >> value_bits),
+                  4);
+    memcpy(image + section_offsets[0], dictionary.nodes_,
+           dictionary.node_count_ * sizeof(DictionaryNode));
+    memcpy(image + section_offsets[1], dictionary.anchor_offsets_,
+           (dictionary.max_word_size_ * ALPHABET_SIZE + 1) * sizeof(int));
+    memcpy(image + section_offsets[2], dictionary.anchor_nodes_,
+           dictionary.node_count_ * sizeof(int));
+    memcpy(image + section_offsets[3], dictionary.anagram_nodes_,
+           dictionary.word_count_ * sizeof(int));
+    memcpy(image + section_offsets[4], dictionary.anagram_offsets_,
+           (dictionary.anagram_class_count_ + 1) * sizeof(int));
+    memcpy(image + section_offsets[5], dictionary.anagram_slots_,
+           dictionary.anagram_slot_count_ * sizeof(int));
+    memcpy(image + section_offsets[6], dictionary.anagram_keys_,
+           (dictionary.anagram_class_count_ + 1) *
+           sizeof(unsigned long long));
+    return_value = writeMappedFile(image_name, image, image_size);
+    if(return_value == SUCCESS)
+      printf("%d words written to %s\n", dictionary.word_count_, image_name);
+    else if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Cannot open file: %s\n", image_name);
+  }
+  if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+  free(image);
+  free(image_name);
+  freeDictionary(&dictionary);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function reserveArchiveColumn, we make room for more bytes at the
+/// end of a column.
+///
+/// @param archive_column the column.
+/// @param extra_size the number of bytes to add.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int reserveArchiveColumn(ArchiveColumn* archive_column, size_t extra_size)
+{
+  size_t first_capacity = 256;
+  if(archive_column->size_ + extra_size <= archive_column->capacity_)
+    return SUCCESS;
+  size_t new_capacity = archive_column->capacity_ * 2;
+  if(new_capacity < first_capacity)
+    new_capacity = first_capacity;
+  while(new_capacity < archive_column->size_ + extra_size)
+    new_capacity *= 2;
+  unsigned char* new_bytes =
+      (unsigned char*)realloc(archive_column->bytes_, new_capacity);
+  if(new_bytes == NULL)
+    return OUT_MEMORY_ERROR;
+  archive_column->bytes_ = new_bytes;
+  archive_column->capacity_ = new_capacity;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function putArchiveVarint, we append a number with 7 bits per
+/// byte, the high bit marking that more bytes follow.
+///
+/// @param archive_column a column of numbers.
+/// @param value the number.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int putArchiveVarint(ArchiveColumn* archive_column, unsigned int value)
+{
+  int max_varint_size = 5;
+  unsigned int more_bit = 0x80;
+  unsigned int value_mask = 0x7f;
+  int value_bits = 7;
+  if(reserveArchiveColumn(archive_column, max_varint_size) != SUCCESS)
+    return OUT_MEMORY_ERROR;
+  while(value > value_mask)
+  {
+    archive_column->bytes_[archive_column->size_++] =
+        (unsigned char)((value & value_mask) | more_bit);
+    value >>= value_bits;
+  }
+  archive_column->bytes_[archive_column->size_++] = (unsigned char)value;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function putArchiveBits, we append the low bits of a number to a
+/// column of bits, lowest bit first.
+///
+/// @param archive_column a column of bits.
+/// @param value the number.
+/// @param bits the number of bits, at most 24.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int putArchiveBits(ArchiveColumn* archive_column, unsigned int value,
+                   int bits)
+{
+  int byte_bits = 8;
+  int max_bytes = 4;
+  if(reserveArchiveColumn(archive_column, max_bytes) != SUCCESS)
+    return OUT_MEMORY_ERROR;
+  while(bits > 0)
+  {
+    size_t byte_index = archive_column->bit_count_ / byte_bits;
+    int bit_offset = (int)(archive_column->bit_count_ % byte_bits);
+    if(bit_offset == 0)
+      archive_column->bytes_[archive_column->size_++] = 0;
+    int bits_here = byte_bits - bit_offset;
+    if(bits_here > bits)
+      bits_here = bits;
+    archive_column->bytes_[byte_index] |=
+        (unsigned char)((value & ((1u << bits_here) - 1)) << bit_offset);
+    value >>= bits_here;
+    bits -= bits_here;
+    archive_column->bit_count_ += bits_here;
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function getArchiveVarint, we read the next number of a column
+/// written by putArchiveVarint.
+///
+/// @param archive_cursor position in the column.
+/// @param value receives the number.
+///
+/// @return error_return_value if the column ends before the number.
+/// @return SUCCESS otherwise.
+//
+int getArchiveVarint(ArchiveCursor* archive_cursor, unsigned int* value)
+{
+  int error_return_value = 1;
+  unsigned int more_bit = 0x80;
+  unsigned int value_mask = 0x7f;
+  int value_bits = 7;
+  int max_shift = 28;
+  int shift = 0;
+  *value = 0;
+  while(archive_cursor->position_ < archive_cursor->size_)
+  {
+    unsigned int byte = archive_cursor->bytes_[archive_cursor->position_++];
+    *value |= (byte & value_mask) << shift;
+    if(!(byte & more_bit))
+      return SUCCESS;
+    shift += value_bits;
+    if(shift > max_shift)
+      break;
+  }
+  return error_return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function getArchiveBits, we read the next bits of a column
+/// written by putArchiveBits.
+///
+/// @param archive_cursor position in the column, counted in bits.
+/// @param bits the number of bits, at most 24.
+/// @param value receives the number.
+///
+/// @return error_return_value if the column ends before the bits.
+/// @return SUCCESS otherwise.
+//
+int getArchiveBits(ArchiveCursor* archive_cursor, int bits,
+                   unsigned int* value)
+{
+  int error_return_value = 1;
+  int byte_bits = 8;
+  if(archive_cursor->position_ + bits > archive_cursor->size_ * byte_bits)
+    return error_return_value;
+  *value = 0;
+  int value_shift = 0;
+  while(bits > 0)
+  {
+    unsigned int byte =
+        archive_cursor->bytes_[archive_cursor->position_ / byte_bits];
+    int bit_offset = (int)(archive_cursor->position_ % byte_bits);
+    int bits_here = byte_bits - bit_offset;
+    if(bits_here > bits)
+      bits_here = bits;
+    *value |= ((byte >> bit_offset) & ((1u << bits_here) - 1)) <<
+              value_shift;
+    value_shift += bits_here;
+    bits -= bits_here;
+    archive_cursor->position_ += bits_here;
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function openArchiveCursor, we start reading a column of a
+/// block.
+///
+/// @param archive_block the block.
+/// @param column_index the column, one of the ARCHIVE_ numbers.
+/// @param archive_cursor receives the position at the start of the column.
+///
+/// @return
+//
+void openArchiveCursor(const ArchiveBlock* archive_block, int column_index,
+                       ArchiveCursor* archive_cursor)
+{
+  archive_cursor->bytes_ = archive_block->columns_[column_index];
+  archive_cursor->size_ = archive_block->column_sizes_[column_index];
+  archive_cursor->position_ = 0;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function addArchiveMove, we add a move to the record of a game.
+///
+/// @param archive_game the game.
+/// @param field_move the move.
+/// @param player the player who made it, 1 or 2.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int addArchiveMove(ArchiveGame* archive_game, const FieldMove* field_move,
+                   int player)
+{
+  int move_capacity = archive_game->move_capacity_;
+  FieldMove* archive_move = appendFieldMove(&archive_game->moves_,
+                                            &archive_game->move_count_,
+                                            &archive_game->move_capacity_);
+  if(archive_move == NULL)
+    return OUT_MEMORY_ERROR;
+  if(archive_game->move_capacity_ != move_capacity)
+  {
+    int* new_players = (int*)realloc(archive_game->move_players_,
+                                     archive_game->move_capacity_ *
+                                     sizeof(int));
+    if(new_players == NULL)
+    {
+      archive_game->move_count_--;
+      return OUT_MEMORY_ERROR;
+    }
+    archive_game->move_players_ = new_players;
+  }
+  *archive_move = *field_move;
+  archive_game->move_players_[archive_game->move_count_ - 1] = player;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function openArchiveWriter, we open an archive to append games
+/// to. A new or empty file gets the archive header first.
+///
+/// @param archive_name name of the archive file.
+/// @param archive_writer receives the writer.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be opened.
+/// @return INVALID_CONFIG_FILE if the file is not an archive.
+/// @return SUCCESS otherwise.
+//
+int openArchiveWriter(const char* archive_name, ArchiveWriter* archive_writer)
+{
+  memset(archive_writer, 0, sizeof(ArchiveWriter));
+  archive_writer->file_ = fopen(archive_name, "ab+");
+  if(archive_writer->file_ == NULL)
+    return CANNOT_OPEN_CONFIG_FILE;
+  char archive_magic[ARCHIVE_MAGIC_SIZE];
+  fseek(archive_writer->file_, 0, SEEK_SET);
+  size_t magic_size = fread(archive_magic, 1, ARCHIVE_MAGIC_SIZE,
+                            archive_writer->file_);
+  if(((magic_size != 0) && (magic_size != ARCHIVE_MAGIC_SIZE)) ||
+     ((magic_size == ARCHIVE_MAGIC_SIZE) &&
+      (memcmp(archive_magic, ARCHIVE_MAGIC, ARCHIVE_MAGIC_SIZE) != 0)))
+  {
+    fclose(archive_writer->file_);
+    archive_writer->file_ = NULL;
+    return INVALID_CONFIG_FILE;
+  }
+  fseek(archive_writer->file_, 0, SEEK_END);
+  if((magic_size == 0) &&
+     ((fwrite(ARCHIVE_MAGIC, 1, ARCHIVE_MAGIC_SIZE, archive_writer->file_) !=
+       ARCHIVE_MAGIC_SIZE) || (fflush(archive_writer->file_) != 0)))
+  {
+    fclose(archive_writer->file_);
+    archive_writer->file_ = NULL;
+    return CANNOT_OPEN_CONFIG_FILE;
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function appendArchiveGame, we add a finished game to the block
+/// being built. A full block is written at once.
+///
+/// @param archive_writer the writer.
+/// @param archive_game the game.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return CANNOT_OPEN_CONFIG_FILE if the block cannot be written.
+/// @return SUCCESS otherwise.
+//
+int appendArchiveGame(ArchiveWriter* archive_writer,
+                      const ArchiveGame* archive_game)
+{
+  char first_letter = 'a';
+  int player_1 = 1;
+  int player_2 = 2;
+  int draw = 0;
+  ArchiveColumn* columns = archive_writer->columns_;
+  int letters_size = (int)strlen(archive_game->char_points_string_);
+  int winner = draw;
+  if(archive_game->player1_points_ > archive_game->player2_points_)
+    winner = player_1;
+  if(archive_game->player2_points_ > archive_game->player1_points_)
+    winner = player_2;
+
+  int return_value = SUCCESS;
+  if((putArchiveVarint(&columns[ARCHIVE_LETTERS], letters_size) !=
+      SUCCESS) ||
+     (reserveArchiveColumn(&columns[ARCHIVE_LETTERS], letters_size) !=
+      SUCCESS) ||
+     (putArchiveVarint(&columns[ARCHIVE_START], archive_game->packed_size_) !=
+      SUCCESS) ||
+     (reserveArchiveColumn(&columns[ARCHIVE_START],
+                           archive_game->packed_size_) != SUCCESS) ||
+     (putArchiveVarint(&columns[ARCHIVE_FIELD_SIZE],
+                       archive_game->field_size_) != SUCCESS) ||
+     (putArchiveVarint(&columns[ARCHIVE_MOVE_COUNT],
+                       archive_game->move_count_) != SUCCESS) ||
+     (putArchiveVarint(&columns[ARCHIVE_FINAL_POINTS],
+                       archive_game->player1_points_) != SUCCESS) ||
+     (putArchiveVarint(&columns[ARCHIVE_FINAL_POINTS],
+                       archive_game->player2_points_) != SUCCESS) ||
+     (putArchiveVarint(&columns[ARCHIVE_WINNER], winner) != SUCCESS))
+    return_value = OUT_MEMORY_ERROR;
+  if(return_value == SUCCESS)
+  {
+    ArchiveColumn* letters_column = &columns[ARCHIVE_LETTERS];
+    memcpy(letters_column->bytes_ + letters_column->size_,
+           archive_game->char_points_string_, letters_size);
+    letters_column->size_ += letters_size;
+    ArchiveColumn* start_column = &columns[ARCHIVE_START];
+    memcpy(start_column->bytes_ + start_column->size_, archive_game->packed_,
+           archive_game->packed_size_);
+    start_column->size_ += archive_game->packed_size_;
+  }
+
+  int move_iterator = 0;
+  for(move_iterator = 0;
+      (return_value == SUCCESS) && (move_iterator < archive_game->move_count_);
+      move_iterator++)
+  {
+    const FieldMove* field_move = &archive_game->moves_[move_iterator];
+    int word_size = (int)strlen(field_move->word_);
+    if((putArchiveVarint(&columns[ARCHIVE_MOVE_ROWS], field_move->row_) !=
+        SUCCESS) ||
+       (putArchiveVarint(&columns[ARCHIVE_MOVE_COLUMNS],
+                         field_move->column_) != SUCCESS) ||
+       (putArchiveBits(&columns[ARCHIVE_ORIENTATIONS],
+                       field_move->orientation_ != 0, 1) != SUCCESS) ||
+       (putArchiveBits(&columns[ARCHIVE_PLAYERS],
+                       archive_game->move_players_[move_iterator] == player_2,
+                       1) != SUCCESS) ||
+       (putArchiveVarint(&columns[ARCHIVE_MOVE_POINTS],
+                         field_move->points_) != SUCCESS) ||
+       (putArchiveVarint(&columns[ARCHIVE_WORD_SIZES], word_size) != SUCCESS))
+      return_value = OUT_MEMORY_ERROR;
+    int letter_iterator = 0;
+    for(letter_iterator = 0;
+        (return_value == SUCCESS) && (letter_iterator < word_size);
+        letter_iterator++)
+      return_value = putArchiveBits(
+          &columns[ARCHIVE_WORD_LETTERS],
+          tolower(field_move->word_[letter_iterator]) - first_letter,
+          PACKED_LETTER_BITS);
+  }
+  if(return_value != SUCCESS)
+    return return_value;
+  archive_writer->game_count_++;
+  archive_writer->move_count_ += archive_game->move_count_;
+  if(archive_writer->game_count_ == ARCHIVE_BLOCK_GAMES)
+    return flushArchiveBlock(archive_writer);
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function flushArchiveBlock, we write the block being built and
+/// start a new one. A block is
+///   u32 game count, u32 move count, u32 size of every column, the columns
+/// so a reader can step over the columns it does not need.
+///
+/// @param archive_writer the writer.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the block cannot be written.
+/// @return SUCCESS otherwise.
+//
+int flushArchiveBlock(ArchiveWriter* archive_writer)
+{
+  unsigned char block_header[ARCHIVE_BLOCK_HEADER_SIZE];
+  if(archive_writer->game_count_ == 0)
+    return SUCCESS;
+  putDeltaValue(block_header, archive_writer->game_count_, 4);
+  putDeltaValue(block_header + 4, archive_writer->move_count_, 4);
+  int column_iterator = 0;
+  for(column_iterator = 0; column_iterator < ARCHIVE_COLUMN_COUNT;
+      column_iterator++)
+    putDeltaValue(block_header + 8 + 4 * column_iterator,
+                  (unsigned int)archive_writer->columns_[column_iterator].size_,
+                  4);
+  int return_value = SUCCESS;
+  if(fwrite(block_header, 1, ARCHIVE_BLOCK_HEADER_SIZE,
+            archive_writer->file_) != ARCHIVE_BLOCK_HEADER_SIZE)
+    return_value = CANNOT_OPEN_CONFIG_FILE;
+  for(column_iterator = 0; column_iterator < ARCHIVE_COLUMN_COUNT;
+      column_iterator++)
+  {
+    ArchiveColumn* archive_column = &archive_writer->columns_[column_iterator];
+    if((archive_column->size_ > 0) &&
+       (fwrite(archive_column->bytes_, 1, archive_column->size_,
+               archive_writer->file_) != archive_column->size_))
+      return_value = CANNOT_OPEN_CONFIG_FILE;
+    archive_column->size_ = 0;
+    archive_column->bit_count_ = 0;
+  }
+  if(fflush(archive_writer->file_) != 0)
+    return_value = CANNOT_OPEN_CONFIG_FILE;
+  archive_writer->game_count_ = 0;
+  archive_writer->move_count_ = 0;
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function closeArchiveWriter, we write the last block and close
+/// the archive.
+///
+/// @param archive_writer the writer, may be closed already.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the block cannot be written.
+/// @return SUCCESS otherwise.
+//
+int closeArchiveWriter(ArchiveWriter* archive_writer)
+{
+  if(archive_writer->file_ == NULL)
+    return SUCCESS;
+  int return_value = flushArchiveBlock(archive_writer);
+  if(fclose(archive_writer->file_) != 0)
+    return_value = CANNOT_OPEN_CONFIG_FILE;
+  int column_iterator = 0;
+  for(column_iterator = 0; column_iterator < ARCHIVE_COLUMN_COUNT;
+      column_iterator++)
+    free(archive_writer->columns_[column_iterator].bytes_);
+  memset(archive_writer, 0, sizeof(ArchiveWriter));
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function openArchiveReader, we map an archive read only for one
+/// pass from the first block to the last.
+///
+/// @param archive_name name of the archive file.
+/// @param archive_reader receives the reader.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be mapped.
+/// @return INVALID_CONFIG_FILE if the file is not an archive.
+/// @return SUCCESS otherwise.
+//
+int openArchiveReader(const char* archive_name, ArchiveReader* archive_reader)
+{
+  memset(archive_reader, 0, sizeof(ArchiveReader));
+  int archive_file = open(archive_name, O_RDONLY);
+  if(archive_file < 0)
+    return CANNOT_OPEN_CONFIG_FILE;
+  struct stat archive_stat;
+  if((fstat(archive_file, &archive_stat) != 0) ||
+     (archive_stat.st_size < ARCHIVE_MAGIC_SIZE))
+  {
+    close(archive_file);
+    return INVALID_CONFIG_FILE;
+  }
+  size_t map_size = (size_t)archive_stat.st_size;
+  void* archive_map = mmap(NULL, map_size, PROT_READ, MAP_SHARED,
+                           archive_file, 0);
+  close(archive_file);
+  if(archive_map == MAP_FAILED)
+    return CANNOT_OPEN_CONFIG_FILE;
+  if(memcmp(archive_map, ARCHIVE_MAGIC, ARCHIVE_MAGIC_SIZE) != 0)
+  {
+    munmap(archive_map, map_size);
+    return INVALID_CONFIG_FILE;
+  }
+  // the blocks are read in order, so the kernel can read ahead
+  madvise(archive_map, map_size, MADV_SEQUENTIAL);
+  archive_reader->map_ = (const unsigned char*)archive_map;
+  archive_reader->map_size_ = map_size;
+  archive_reader->position_ = ARCHIVE_MAGIC_SIZE;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function nextArchiveBlock, we find the columns of the next block.
+/// Nothing is decoded, so the columns not read are never touched.
+///
+/// @param archive_reader the reader.
+/// @param archive_block receives the block.
+///
+/// @return error_return_value if there are no more blocks.
+/// @return INVALID_CONFIG_FILE if the block is cut off.
+/// @return SUCCESS otherwise.
+//
+int nextArchiveBlock(ArchiveReader* archive_reader,
+                     ArchiveBlock* archive_block)
+{
+  int error_return_value = 1;
+  size_t bytes_left = archive_reader->map_size_ - archive_reader->position_;
+  if(bytes_left == 0)
+    return error_return_value;
+  if(bytes_left < ARCHIVE_BLOCK_HEADER_SIZE)
+    return INVALID_CONFIG_FILE;
+  const unsigned char* block_header =
+      archive_reader->map_ + archive_reader->position_;
+  archive_block->game_count_ = (int)getDeltaValue(block_header, 4);
+  archive_block->move_count_ = (int)getDeltaValue(block_header + 4, 4);
+  size_t column_offset = ARCHIVE_BLOCK_HEADER_SIZE;
+  int column_iterator = 0;
+  for(column_iterator = 0; column_iterator < ARCHIVE_COLUMN_COUNT;
+      column_iterator++)
+  {
+    size_t column_size =
+        getDeltaValue(block_header + 8 + 4 * column_iterator, 4);
+    if(column_size > bytes_left - column_offset)
+      return INVALID_CONFIG_FILE;
+    archive_block->columns_[column_iterator] = block_header + column_offset;
+    archive_block->column_sizes_[column_iterator] = column_size;
+    column_offset += column_size;
+  }
+  archive_reader->position_ += column_offset;
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function closeArchiveReader, we unmap an archive.
+///
+/// @param archive_reader the reader, may be empty.
+///
+/// @return
+//
+void closeArchiveReader(ArchiveReader* archive_reader)
+{
+  if(archive_reader->map_ != NULL)
+    munmap((void*)archive_reader->map_, archive_reader->map_size_);
+  memset(archive_reader, 0, sizeof(ArchiveReader));
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printArchiveColumn, we print the values of one column of
+/// a block, one game or move per line.
+///
+/// @param archive_block the block.
+/// @param column_index the column, one of the ARCHIVE_ numbers.
+///
+/// @return INVALID_CONFIG_FILE if the column ends too early.
+/// @return SUCCESS otherwise.
+//
+int printArchiveColumn(const ArchiveBlock* archive_block, int column_index)
+{
+  char first_letter = 'a';
+  int value_count = archive_block->game_count_;
+  if(column_index >= ARCHIVE_MOVE_ROWS)
+    value_count = archive_block->move_count_;
+  // words are read through their sizes
+  int cursor_column = column_index;
+  if(column_index == ARCHIVE_WORD_LETTERS)
+    cursor_column = ARCHIVE_WORD_SIZES;
+  ArchiveCursor archive_cursor;
+  ArchiveCursor letters_cursor;
+  openArchiveCursor(archive_block, cursor_column, &archive_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_WORD_LETTERS, &letters_cursor);
+  int value_iterator = 0;
+  for(value_iterator = 0; value_iterator < value_count; value_iterator++)
+  {
+    unsigned int value = 0;
+    unsigned int second_value = 0;
+    int return_value = SUCCESS;
+    if((column_index == ARCHIVE_ORIENTATIONS) ||
+       (column_index == ARCHIVE_PLAYERS))
+      return_value = getArchiveBits(&archive_cursor, 1, &value);
+    else
+      return_value = getArchiveVarint(&archive_cursor, &value);
+    if((return_value == SUCCESS) &&
+       ((column_index == ARCHIVE_LETTERS) ||
+        (column_index == ARCHIVE_START)) &&
+       (value > archive_cursor.size_ - archive_cursor.position_))
+      return_value = INVALID_CONFIG_FILE;
+    if((return_value == SUCCESS) && (column_index == ARCHIVE_FINAL_POINTS))
+      return_value = getArchiveVarint(&archive_cursor, &second_value);
+    if(return_value != SUCCESS)
+      return INVALID_CONFIG_FILE;
+
+    const unsigned char* bytes =
+        archive_cursor.bytes_ + archive_cursor.position_;
+    unsigned int byte_iterator = 0;
+    if(column_index == ARCHIVE_LETTERS)
+      printf("%.*s\n", (int)value, (const char*)bytes);
+    else if(column_index == ARCHIVE_START)
+    {
+      for(byte_iterator = 0; byte_iterator < value; byte_iterator++)
+        printf("%02x", bytes[byte_iterator]);
+      printf("\n");
+    }
+    else if(column_index == ARCHIVE_FINAL_POINTS)
+      printf("%u %u\n", value, second_value);
+    else if(column_index == ARCHIVE_WORD_LETTERS)
+    {
+      for(byte_iterator = 0; byte_iterator < value; byte_iterator++)
+      {
+        unsigned int letter = 0;
+        if(getArchiveBits(&letters_cursor, PACKED_LETTER_BITS, &letter) !=
+           SUCCESS)
+          return INVALID_CONFIG_FILE;
+        printf("%c", first_letter + (int)letter);
+      }
+      printf("\n");
+    }
+    else
+      printf("%u\n", value);
+    if((column_index == ARCHIVE_LETTERS) || (column_index == ARCHIVE_START))
+      archive_cursor.position_ += value;
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function readArchive, we print the size of every column of an
+/// archive or, with a column name, its values. Only the blocks' headers and
+/// the wanted column are read.
+///
+/// @param archive_name name of the archive file.
+/// @param column_name name of the column to print, NULL for the sizes.
+///
+/// @return WRONG_ARGUMENTS_NR if the column is unknown.
+/// @return CANNOT_OPEN_CONFIG_FILE if the file cannot be opened.
+/// @return INVALID_CONFIG_FILE if the file is not a valid archive.
+/// @return SUCCESS otherwise.
+//
+int readArchive(char* archive_name, char* column_name)
+{
+  int error_return_value = 1;
+  const char* column_names[ARCHIVE_COLUMN_COUNT] = {
+      "letters", "start", "size", "moves", "points", "winner", "rows",
+      "columns", "orientations", "players", "move_points", "words",
+      "word_sizes"};
+  int column_index = ARCHIVE_COLUMN_COUNT;
+  int column_iterator = 0;
+  for(column_iterator = 0;
+      (column_name != NULL) && (column_iterator < ARCHIVE_COLUMN_COUNT);
+      column_iterator++)
+    if(strcmp(column_name, column_names[column_iterator]) == 0)
+      column_index = column_iterator;
+  if((column_name != NULL) && (column_index == ARCHIVE_COLUMN_COUNT))
+  {
+    printf("Error: Unknown column: %s\n", column_name);
+    return WRONG_ARGUMENTS_NR;
+  }
+
+  ArchiveReader archive_reader;
+  int return_value = openArchiveReader(archive_name, &archive_reader);
+  if(return_value == CANNOT_OPEN_CONFIG_FILE)
+    printf("Error: Cannot open file: %s\n", archive_name);
+  if(return_value == INVALID_CONFIG_FILE)
+    printf("Error: Invalid file: %s\n", archive_name);
+  if(return_value != SUCCESS)
+    return return_value;
+
+  long game_count = 0;
+  long move_count = 0;
+  size_t column_sizes[ARCHIVE_COLUMN_COUNT];
+  memset(column_sizes, 0, sizeof(column_sizes));
+  ArchiveBlock archive_block;
+  while((return_value = nextArchiveBlock(&archive_reader, &archive_block)) ==
+        SUCCESS)
+  {
+    game_count += archive_block.game_count_;
+    move_count += archive_block.move_count_;
+    for(column_iterator = 0; column_iterator < ARCHIVE_COLUMN_COUNT;
+        column_iterator++)
+      column_sizes[column_iterator] +=
+          archive_block.column_sizes_[column_iterator];
+    if((column_name != NULL) &&
+       (printArchiveColumn(&archive_block, column_index) != SUCCESS))
+    {
+      return_value = INVALID_CONFIG_FILE;
+      break;
+    }
+  }
+  closeArchiveReader(&archive_reader);
+  if(return_value == INVALID_CONFIG_FILE)
+  {
+    printf("Error: Invalid file: %s\n", archive_name);
+    return INVALID_CONFIG_FILE;
+  }
+  if(column_name == NULL)
+  {
+    printf("%ld games, %ld moves\n", game_count, move_count);
+    for(column_iterator = 0; column_iterator < ARCHIVE_COLUMN_COUNT;
+        column_iterator++)
+      printf("%-14s %10lu bytes\n", column_names[column_iterator],
+             (unsigned long)column_sizes[column_iterator]);
+  }
+  if(return_value == error_return_value)
+    return_value = SUCCESS;
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function addPositionStats, we count the letters of a final
+/// position and the cells they are on.
+///
+/// @param corpus_stats the aggregates of the thread.
+/// @param game_play_field the position.
+/// @param board_kernels board operations for the size of the field.
+/// @param letter_table letters and points of the game.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int addPositionStats(CorpusStats* corpus_stats, Word** game_play_field,
+                     const BoardKernels* board_kernels,
+                     const LetterTable* letter_table)
+{
+  char space = ' ';
+  char first_letter = 'a';
+  int field_size = board_kernels->field_size_;
+  if(corpus_stats->heatmaps_[field_size] == NULL)
+  {
+    corpus_stats->heatmaps_[field_size] =
+        (long*)calloc(field_size * field_size, sizeof(long));
+    if(corpus_stats->heatmaps_[field_size] == NULL)
+      return OUT_MEMORY_ERROR;
+  }
+  long* heatmap = corpus_stats->heatmaps_[field_size];
+  corpus_stats->heatmap_positions_[field_size]++;
+
+  char field_segment[FIELD_SEGMENT_BUFFER];
+  int row_iterator = 0;
+  for(row_iterator = 0; row_iterator < field_size; row_iterator++)
+  {
+    board_kernels->load_segment_(game_play_field, field_size, row_iterator, 0,
+                                 0, field_size, field_segment);
+    int column_iterator = 0;
+    for(column_iterator = 0; column_iterator < field_size; column_iterator++)
+    {
+      if(field_segment[column_iterator] == space)
+        continue;
+      heatmap[row_iterator * field_size + column_iterator]++;
+      int letter_index = field_segment[column_iterator] - first_letter;
+      if((letter_index < 0) || (letter_index >= ALPHABET_SIZE))
+        continue;
+      corpus_stats->letter_counts_[letter_index]++;
+      corpus_stats->letter_points_[letter_index] +=
+          letter_table->points_[letter_index];
+    }
+  }
+  return SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function analyzeSavedPosition, we read a saved config through the
+/// config parser and count its position.
+///
+/// @param corpus_stats the aggregates of the thread.
+/// @param config_name name of the config file.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise, a file which cannot be read is counted.
+//
+int analyzeSavedPosition(CorpusStats* corpus_stats, char* config_name)
+{
+  FILE* config_text = fopen(config_name, "r");
+  if(config_text == NULL)
+  {
+    corpus_stats->unreadable_files_++;
+    return SUCCESS;
+  }
+  char* char_points_string = NULL;
+  int player1_points = 0;
+  int player2_points = 0;
+  int field_size = 0;
+  int player_turn = 0;
+  int return_value = 0;
+  char** file_elements_array = getConfigContent(config_text, &return_value,
+                                                &char_points_string,
+                                                &player1_points,
+                                                &player2_points,
+                                                &field_size,
+                                                &player_turn);
+  if(file_elements_array == NULL)
+  {
+    if(return_value == OUT_MEMORY_ERROR)
+      return OUT_MEMORY_ERROR;
+    corpus_stats->unreadable_files_++;
+    return SUCCESS;
+  }
+  BoardKernels board_kernels;
+  LetterTable letter_table;
+  getBoardKernels(field_size, &board_kernels);
+  buildLetterTable(char_points_string, &letter_table);
+  Word** game_play_field = initializeGameField(file_elements_array,
+                                               char_points_string,
+                                               &board_kernels);
+  if(game_play_field == NULL)
+    return OUT_MEMORY_ERROR;
+  free(char_points_string);
+  return_value = addPositionStats(corpus_stats, game_play_field,
+                                  &board_kernels, &letter_table);
+  corpus_stats->saved_positions_++;
+  board_kernels.free_field_(game_play_field, field_size);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function analyzeArchiveBlock, we replay the games of an archive
+/// block with the insert logic and count their moves and final positions.
+/// The final points, winners, players and stored move points are not
+/// needed, so those columns are never read.
+///
+/// @param corpus_stats the aggregates of the thread.
+/// @param archive_block the block.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return INVALID_CONFIG_FILE if a column ends too early or holds a value
+///                             out of range.
+/// @return SUCCESS otherwise.
+//
+int analyzeArchiveBlock(CorpusStats* corpus_stats,
+                        const ArchiveBlock* archive_block)
+{
+  char eos = '\0';
+  char first_letter = 'a';
+  ArchiveCursor letters_cursor;
+  ArchiveCursor start_cursor;
+  ArchiveCursor size_cursor;
+  ArchiveCursor move_count_cursor;
+  ArchiveCursor rows_cursor;
+  ArchiveCursor columns_cursor;
+  ArchiveCursor orientations_cursor;
+  ArchiveCursor word_sizes_cursor;
+  ArchiveCursor word_letters_cursor;
+  openArchiveCursor(archive_block, ARCHIVE_LETTERS, &letters_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_START, &start_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_FIELD_SIZE, &size_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_MOVE_COUNT, &move_count_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_MOVE_ROWS, &rows_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_MOVE_COLUMNS, &columns_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_ORIENTATIONS,
+                    &orientations_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_WORD_SIZES, &word_sizes_cursor);
+  openArchiveCursor(archive_block, ARCHIVE_WORD_LETTERS,
+                    &word_letters_cursor);
+
+  char letters[CORPUS_LETTERS_SIZE];
+  char word[MOVE_WORD_SIZE];
+  int game_iterator = 0;
+  for(game_iterator = 0; game_iterator < archive_block->game_count_;
+      game_iterator++)
+  {
+    unsigned int letters_size = 0;
+    unsigned int start_size = 0;
+    unsigned int field_size = 0;
+    unsigned int move_count = 0;
+    if((getArchiveVarint(&letters_cursor, &letters_size) != SUCCESS) ||
+       (letters_size >= CORPUS_LETTERS_SIZE) ||
+       (letters_size > letters_cursor.size_ - letters_cursor.position_) ||
+       (getArchiveVarint(&start_cursor, &start_size) != SUCCESS) ||
+       (start_size > start_cursor.size_ - start_cursor.position_) ||
+       (getArchiveVarint(&size_cursor, &field_size) != SUCCESS) ||
+       (field_size < MIN_FIELD_SIZE) ||
+       (field_size > MAX_SPARSE_FIELD_SIZE) ||
+       (getArchiveVarint(&move_count_cursor, &move_count) != SUCCESS))
+      return INVALID_CONFIG_FILE;
+    memcpy(letters, letters_cursor.bytes_ + letters_cursor.position_,
+           letters_size);
+    letters[letters_size] = eos;
+    letters_cursor.position_ += letters_size;
+    const unsigned char* start = start_cursor.bytes_ + start_cursor.position_;
+    start_cursor.position_ += start_size;
+
+    BoardKernels board_kernels;
+    LetterTable letter_table;
+    getBoardKernels((int)field_size, &board_kernels);
+    buildLetterTable(letters, &letter_table);
+    Word** game_play_field = board_kernels.create_field_((int)field_size);
+    if(game_play_field == NULL)
+      return OUT_MEMORY_ERROR;
+    int player1_points = 0;
+    int player2_points = 0;
+    int player_turn = 0;
+    int return_value = decodePackedPosition(start, (int)start_size,
+                                            game_play_field, &board_kernels,
+                                            &letter_table, &player1_points,
+                                            &player2_points, &player_turn);
+    if((return_value != SUCCESS) && (return_value != OUT_MEMORY_ERROR))
+      return_value = INVALID_CONFIG_FILE;
+
+    unsigned int move_iterator = 0;
+    for(move_iterator = 0;
+        (return_value == SUCCESS) && (move_iterator < move_count);
+        move_iterator++)
+    {
+      unsigned int row = 0;
+      unsigned int column = 0;
+      unsigned int orientation = 0;
+      unsigned int word_size = 0;
+      if((getArchiveVarint(&rows_cursor, &row) != SUCCESS) ||
+         (getArchiveVarint(&columns_cursor, &column) != SUCCESS) ||
+         (getArchiveBits(&orientations_cursor, 1, &orientation) != SUCCESS) ||
+         (getArchiveVarint(&word_sizes_cursor, &word_size) != SUCCESS) ||
+         (word_size >= MOVE_WORD_SIZE))
+      {
+        return_value = INVALID_CONFIG_FILE;
+        break;
+      }
+      unsigned int letter_iterator = 0;
+      for(letter_iterator = 0;
+          (return_value == SUCCESS) && (letter_iterator < word_size);
+          letter_iterator++)
+      {
+        unsigned int letter = 0;
+        if(getArchiveBits(&word_letters_cursor, PACKED_LETTER_BITS,
+                          &letter) != SUCCESS)
+          return_value = INVALID_CONFIG_FILE;
+        word[letter_iterator] = (char)(first_letter + (int)letter);
+      }
+      word[word_size] = eos;
+      if(return_value != SUCCESS)
+        break;
+
+      int points_won = 0;
+      return_value = fieldInsertWord(game_play_field, &board_kernels,
+                                     (int)row, (int)column, (int)orientation,
+                                     word, (int)word_size, &letter_table,
+                                     &points_won);
+      if(return_value == OUT_MEMORY_ERROR)
+        break;
+      // a move the insert logic refuses is counted, the game goes on
+      if(return_value == SUCCESS)
+      {
+        corpus_stats->moves_++;
+        corpus_stats->move_points_ += points_won;
+      }
+      else
+        corpus_stats->rejected_moves_++;
+      return_value = SUCCESS;
+    }
+    if(return_value == SUCCESS)
+      return_value = addPositionStats(corpus_stats, game_play_field,
+                                      &board_kernels, &letter_table);
+    board_kernels.free_field_(game_play_field, (int)field_size);
+    if(return_value != SUCCESS)
+      return return_value;
+    corpus_stats->archived_games_++;
+    corpus_stats->game_moves_ += move_count;
+    if((long)move_count > corpus_stats->longest_game_)
+      corpus_stats->longest_game_ = move_count;
   }
   return SUCCESS;
 }
+
+//------------------------------------------------------------------------------
+///
+/// In the function corpusThread, we take the next open piece of work until
+/// all are done or one failed. The counts go to the thread's own
+/// aggregates, so no lock is needed.
+///
+/// @param thread_argument the CorpusThread of the thread.
+///
+/// @return NULL
+//
+void* corpusThread(void* thread_argument)
+{
+  CorpusThread* corpus_thread = (CorpusThread*)thread_argument;
+  Corpus* corpus = corpus_thread->corpus_;
+  while(atomic_load(&corpus->error_) == SUCCESS)
+  {
+    int work_index = atomic_fetch_add(&corpus->next_work_, 1);
+    if(work_index >= corpus->work_count_)
+      break;
+    const CorpusWork* corpus_work = &corpus->work_[work_index];
+    int return_value = SUCCESS;
+    if(corpus_work->is_archive_)
+      return_value = analyzeArchiveBlock(&corpus_thread->corpus_stats_,
+                                         &corpus_work->archive_block_);
+    else
+      return_value = analyzeSavedPosition(
+          &corpus_thread->corpus_stats_,
+          corpus->file_names_[corpus_work->file_index_]);
+    if(return_value != SUCCESS)
+    {
+      corpus_thread->error_file_ = corpus_work->file_index_;
+      atomic_store(&corpus->error_, return_value);
+      break;
+    }
+  }
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function mergeCorpusStats, we add the aggregates of a thread to
+/// the total. The heatmaps of the thread are moved or added and freed.
+///
+/// @param total_stats the total.
+/// @param thread_stats the aggregates of a finished thread.
+///
+/// @return
+//
+void mergeCorpusStats(CorpusStats* total_stats, CorpusStats* thread_stats)
+{
+  total_stats->archived_games_ += thread_stats->archived_games_;
+  total_stats->saved_positions_ += thread_stats->saved_positions_;
+  total_stats->unreadable_files_ += thread_stats->unreadable_files_;
+  total_stats->game_moves_ += thread_stats->game_moves_;
+  total_stats->moves_ += thread_stats->moves_;
+  total_stats->rejected_moves_ += thread_stats->rejected_moves_;
+  total_stats->move_points_ += thread_stats->move_points_;
+  if(thread_stats->longest_game_ > total_stats->longest_game_)
+    total_stats->longest_game_ = thread_stats->longest_game_;
+  int letter_iterator = 0;
+  for(letter_iterator = 0; letter_iterator < ALPHABET_SIZE; letter_iterator++)
+  {
+    total_stats->letter_counts_[letter_iterator] +=
+        thread_stats->letter_counts_[letter_iterator];
+    total_stats->letter_points_[letter_iterator] +=
+        thread_stats->letter_points_[letter_iterator];
+  }
+  int size_iterator = 0;
+  for(size_iterator = MIN_FIELD_SIZE; size_iterator <= MAX_SPARSE_FIELD_SIZE;
+      size_iterator++)
+  {
+    long* thread_heatmap = thread_stats->heatmaps_[size_iterator];
+    if(thread_heatmap == NULL)
+      continue;
+    total_stats->heatmap_positions_[size_iterator] +=
+        thread_stats->heatmap_positions_[size_iterator];
+    thread_stats->heatmaps_[size_iterator] = NULL;
+    long* total_heatmap = total_stats->heatmaps_[size_iterator];
+    if(total_heatmap == NULL)
+    {
+      total_stats->heatmaps_[size_iterator] = thread_heatmap;
+      continue;
+    }
+    int cell_iterator = 0;
+    for(cell_iterator = 0; cell_iterator < size_iterator * size_iterator;
+        cell_iterator++)
+      total_heatmap[cell_iterator] += thread_heatmap[cell_iterator];
+    free(thread_heatmap);
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function printCorpusStats, we print the totals, the letters
+/// against their points and the occupancy of every field size. A cell of
+/// a heatmap shows in tenths how many of the positions use it.
+///
+/// @param corpus_stats the merged aggregates.
+///
+/// @return
+//
+void printCorpusStats(const CorpusStats* corpus_stats)
+{
+  char unused_cell = '.';
+  char first_tenth = '0';
+  int last_tenth = 9;
+  int tenths = 10;
+  double percent = 100.0;
+  long archived_games = corpus_stats->archived_games_;
+  long all_moves = corpus_stats->moves_ + corpus_stats->rejected_moves_;
+  printf("%ld archived games, %ld saved positions, %ld unreadable files\n",
+         archived_games, corpus_stats->saved_positions_,
+         corpus_stats->unreadable_files_);
+  printf("%ld moves, %.2f per game, longest game %ld moves\n", all_moves,
+         archived_games ? (double)corpus_stats->game_moves_ / archived_games
+                        : 0.0,
+         corpus_stats->longest_game_);
+  printf("%.2f points per move, %ld moves rejected\n",
+         corpus_stats->moves_ ? (double)corpus_stats->move_points_ /
+                                corpus_stats->moves_
+                              : 0.0,
+         corpus_stats->rejected_moves_);
+
+  long letter_total = 0;
+  int letter_iterator = 0;
+  for(letter_iterator = 0; letter_iterator < ALPHABET_SIZE; letter_iterator++)
+    letter_total += corpus_stats->letter_counts_[letter_iterator];
+  printf("Letter %10s %7s %7s\n", "Count", "Share", "Points");
+  for(letter_iterator = 0; letter_iterator < ALPHABET_SIZE; letter_iterator++)
+  {
+    long letter_count = corpus_stats->letter_counts_[letter_iterator];
+    if(letter_count == 0)
+      continue;
+    printf("%-6c %10ld %6.2f%% %7.2f\n", 'A' + letter_iterator, letter_count,
+           percent * letter_count / letter_total,
+           (double)corpus_stats->letter_points_[letter_iterator] /
+           letter_count);
+  }
+
+  int size_iterator = 0;
+  for(size_iterator = MIN_FIELD_SIZE; size_iterator <= MAX_SPARSE_FIELD_SIZE;
+      size_iterator++)
+  {
+    const long* heatmap = corpus_stats->heatmaps_[size_iterator];
+    long positions = corpus_stats->heatmap_positions_[size_iterator];
+    if(heatmap == NULL)
+      continue;
+    long used_cells = 0;
+    int cell_iterator = 0;
+    for(cell_iterator = 0; cell_iterator < size_iterator * size_iterator;
+        cell_iterator++)
+      used_cells += heatmap[cell_iterator];
+    printf("Occupancy of %dx%d fields, %ld positions, %.2f%% of the cells\n",
+           size_iterator, size_iterator, positions,
+           percent * used_cells / ((double)positions * size_iterator *
+                                   size_iterator));
+    if(size_iterator > MAX_FIELD_SIZE)
+      continue;
+    int row_iterator = 0;
+    for(row_iterator = 0; row_iterator < size_iterator; row_iterator++)
+    {
+      int column_iterator = 0;
+      for(column_iterator = 0; column_iterator < size_iterator;
+          column_iterator++)
+      {
+        long cell_count = heatmap[row_iterator * size_iterator +
+                                  column_iterator];
+        long tenth = cell_count * tenths / positions;
+        if(tenth > last_tenth)
+          tenth = last_tenth;
+        printf("%c", cell_count ? first_tenth + (char)tenth : unused_cell);
+      }
+      printf("\n");
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function analyzeCorpus, we gather statistics over archives of
+/// games and saved configs. Every archive block and every config is one
+/// piece of work for the threads, so memory grows with the aggregates and
+/// the number of blocks, not with the games.
+///
+/// @param file_names names of the archives and config files.
+/// @param file_count the number of files.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if an archive cannot be opened.
+/// @return INVALID_CONFIG_FILE if an archive is not valid.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int analyzeCorpus(char** file_names, int file_count)
+{
+  int first_capacity = 64;
+  int no_file = -1;
+  Corpus corpus;
+  memset(&corpus, 0, sizeof(Corpus));
+  corpus.file_names_ = file_names;
+  corpus.readers_ = (ArchiveReader*)calloc(file_count, sizeof(ArchiveReader));
+  int return_value = SUCCESS;
+  if(corpus.readers_ == NULL)
+    return_value = OUT_MEMORY_ERROR;
+  int work_capacity = 0;
+  int file_iterator = 0;
+  for(file_iterator = 0;
+      (return_value == SUCCESS) && (file_iterator < file_count);
+      file_iterator++)
+  {
+    // archives are told apart from configs by their magic
+    char file_magic[ARCHIVE_MAGIC_SIZE];
+    size_t magic_size = 0;
+    FILE* corpus_file = fopen(file_names[file_iterator], "rb");
+    if(corpus_file != NULL)
+    {
+      magic_size = fread(file_magic, 1, ARCHIVE_MAGIC_SIZE, corpus_file);
+      fclose(corpus_file);
+    }
+    int is_archive = (magic_size == ARCHIVE_MAGIC_SIZE) &&
+                     (memcmp(file_magic, ARCHIVE_MAGIC,
+                             ARCHIVE_MAGIC_SIZE) == 0);
+    if(is_archive)
+      return_value = openArchiveReader(file_names[file_iterator],
+                                       &corpus.readers_[file_iterator]);
+    ArchiveBlock archive_block;
+    int block_value = SUCCESS;
+    while((return_value == SUCCESS) && (block_value == SUCCESS))
+    {
+      if(is_archive)
+        block_value = nextArchiveBlock(&corpus.readers_[file_iterator],
+                                       &archive_block);
+      if((block_value != SUCCESS) && (block_value != INVALID_CONFIG_FILE))
+        break;
+      if(block_value == INVALID_CONFIG_FILE)
+        return_value = INVALID_CONFIG_FILE;
+      if(return_value != SUCCESS)
+        break;
+      if(corpus.work_count_ == work_capacity)
+      {
+        int new_capacity = work_capacity ? 2 * work_capacity : first_capacity;
+        CorpusWork* new_work = (CorpusWork*)realloc(
+            corpus.work_, new_capacity * sizeof(CorpusWork));
+        if(new_work == NULL)
+        {
+          return_value = OUT_MEMORY_ERROR;
+          break;
+        }
+        corpus.work_ = new_work;
+        work_capacity = new_capacity;
+      }
+      CorpusWork* corpus_work = &corpus.work_[corpus.work_count_++];
+      corpus_work->file_index_ = file_iterator;
+      corpus_work->is_archive_ = is_archive;
+      if(!is_archive)
+        break;
+      corpus_work->archive_block_ = archive_block;
+    }
+    if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Cannot open file: %s\n", file_names[file_iterator]);
+    if(return_value == INVALID_CONFIG_FILE)
+      printf("Error: Invalid file: %s\n", file_names[file_iterator]);
+  }
+
+  CorpusStats* total_stats = (CorpusStats*)calloc(1, sizeof(CorpusStats));
+  long thread_count = sysconf(_SC_NPROCESSORS_ONLN);
+  if(thread_count > corpus.work_count_)
+    thread_count = corpus.work_count_;
+  if(thread_count < 1)
+    thread_count = 1;
+  CorpusThread* corpus_threads =
+      (CorpusThread*)calloc(thread_count, sizeof(CorpusThread));
+  if((total_stats == NULL) || (corpus_threads == NULL))
+    return_value = OUT_MEMORY_ERROR;
+  if(return_value == SUCCESS)
+  {
+    atomic_init(&corpus.next_work_, 0);
+    atomic_init(&corpus.error_, SUCCESS);
+    long started_threads = 0;
+    long thread_iterator = 0;
+    for(thread_iterator = 0; thread_iterator < thread_count;
+        thread_iterator++)
+    {
+      corpus_threads[thread_iterator].corpus_ = &corpus;
+      corpus_threads[thread_iterator].error_file_ = no_file;
+    }
+    while((started_threads < thread_count) &&
+          (pthread_create(&corpus_threads[started_threads].thread_, NULL,
+                          corpusThread,
+                          &corpus_threads[started_threads]) == 0))
+      started_threads++;
+    // with no thread at all the work is done here
+    if(started_threads == 0)
+      corpusThread(&corpus_threads[0]);
+    for(thread_iterator = 0; thread_iterator < started_threads;
+        thread_iterator++)
+      pthread_join(corpus_threads[thread_iterator].thread_, NULL);
+    return_value = atomic_load(&corpus.error_);
+    for(thread_iterator = 0; thread_iterator < thread_count;
+        thread_iterator++)
+    {
+      CorpusThread* corpus_thread = &corpus_threads[thread_iterator];
+      if((return_value == INVALID_CONFIG_FILE) &&
+         (corpus_thread->error_file_ != no_file))
+        printf("Error: Invalid file: %s\n",
+               file_names[corpus_thread->error_file_]);
+      mergeCorpusStats(total_stats, &corpus_thread->corpus_stats_);
+    }
+    if(return_value == SUCCESS)
+      printCorpusStats(total_stats);
+  }
+  if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+
+  int size_iterator = 0;
+  for(size_iterator = 0; (total_stats != NULL) &&
+      (size_iterator <= MAX_SPARSE_FIELD_SIZE); size_iterator++)
+    free(total_stats->heatmaps_[size_iterator]);
+  free(total_stats);
+  free(corpus_threads);
+  for(file_iterator = 0; (corpus.readers_ != NULL) &&
+      (file_iterator < file_count); file_iterator++)
+    closeArchiveReader(&corpus.readers_[file_iterator]);
+  free(corpus.readers_);
+  free(corpus.work_);
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function fieldMakeMove, we insert a move and remember the cells
+/// it fills, so fieldUnmakeMove can take it back without a copy of the
+/// field.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param field_move the move.
+/// @param letter_table letters and points of the game.
+/// @param points_won increased by the points of the newly placed letters.
+/// @param move_undo receives the filled cells, none if the insert failed.
+///
+/// @return return_value of fieldInsertWord.
+//
+int fieldMakeMove(Word** game_play_field, const BoardKernels* board_kernels,
+                  const FieldMove* field_move,
+                  const LetterTable* letter_table, int* points_won,
+                  MoveUndo* move_undo)
+{
+  char space = ' ';
+  int field_size = board_kernels->field_size_;
+  int word_size = (int)strlen(field_move->word_);
+  int row_coordinate = field_move->row_;
+  int column_coordinate = field_move->column_;
+  move_undo->count_ = 0;
+  int word_iterator = 0;
+  for(word_iterator = 0; (word_iterator < word_size) &&
+      (row_coordinate < field_size) && (column_coordinate < field_size);
+      word_iterator++)
+  {
+    if(fieldLetter(game_play_field, board_kernels, row_coordinate,
+                   column_coordinate) == space)
+    {
+      move_undo->rows_[move_undo->count_] = row_coordinate;
+      move_undo->columns_[move_undo->count_] = column_coordinate;
+      move_undo->count_++;
+    }
+    if(field_move->orientation_)
+      row_coordinate++;
+    else
+      column_coordinate++;
+  }
+  int return_value = fieldInsertWord(game_play_field, board_kernels,
+                                     field_move->row_, field_move->column_,
+                                     field_move->orientation_,
+                                     field_move->word_, word_size,
+                                     letter_table, points_won);
+  if(return_value != SUCCESS)
+    move_undo->count_ = 0;
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function fieldUnmakeMove, we free the cells a move filled. The
+/// letters it only crossed were there before and stay.
+///
+/// @param game_play_field holds the current state of the game field.
+/// @param board_kernels board operations for the size of the field.
+/// @param move_undo the cells from fieldMakeMove.
+///
+/// @return
+//
+void fieldUnmakeMove(Word** game_play_field, const BoardKernels* board_kernels,
+                     const MoveUndo* move_undo)
+{
+  char space = ' ';
+  int allocate_cell = 0;
+  int cell_iterator = 0;
+  for(cell_iterator = 0; cell_iterator < move_undo->count_; cell_iterator++)
+  {
+    Word* field_cell = board_kernels->cell_(
+        game_play_field, board_kernels->field_size_,
+        move_undo->rows_[cell_iterator], move_undo->columns_[cell_iterator],
+        allocate_cell);
+    if(field_cell == NULL)
+      continue;
+    field_cell->letter_ = space;
+    field_cell->letter_points_ = 0;
+  }
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function simulateMove, we play a candidate and a random
+/// continuation on the field of the thread and take all moves back again.
+/// Both players choose among their MONTE_CARLO_ROLLOUT_MOVES best moves
+/// until one reaches the winning points, neither can move or
+/// MONTE_CARLO_DEPTH moves are played.
+///
+/// @param monte_carlo the evaluation.
+/// @param monte_carlo_thread the thread, its field holds the start position.
+/// @param candidate_index the candidate to play.
+/// @param random_state state of the random numbers of the simulation.
+/// @param margin receives the points of the player to move minus those of
+///               the other player at the end.
+///
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return INVALID_CONFIG_FILE if the candidate cannot be inserted.
+/// @return SUCCESS otherwise.
+//
+int simulateMove(const MonteCarlo* monte_carlo,
+                 MonteCarloThread* monte_carlo_thread, int candidate_index,
+                 unsigned long long* random_state, int* margin)
+{
+  int player_1 = 1;
+  int player_2 = 2;
+  int pass_limit = 2;
+  const TournamentBoard* tournament_board = monte_carlo->board_;
+  const BoardKernels* board_kernels = &tournament_board->board_kernels_;
+  Word** game_play_field = monte_carlo_thread->game_play_field_;
+  MoveUndo* move_undos = monte_carlo_thread->move_undos_;
+  int points[2] = {monte_carlo->player1_points_,
+                   monte_carlo->player2_points_};
+  int player_turn = monte_carlo->player_turn_;
+  TournamentPlayer rollout_player;
+  memset(&rollout_player, 0, sizeof(TournamentPlayer));
+  rollout_player.strategy_ = TOURNAMENT_TOP;
+  rollout_player.parameter_ = MONTE_CARLO_ROLLOUT_MOVES;
+  // rollouts stay random, so they do not play book moves
+  OpeningBook no_book;
+  memset(&no_book, 0, sizeof(OpeningBook));
+
+  int points_won = 0;
+  int return_value = fieldMakeMove(game_play_field, board_kernels,
+                                   &monte_carlo->candidates_[candidate_index],
+                                   &tournament_board->letter_table_,
+                                   &points_won, &move_undos[0]);
+  if(return_value != SUCCESS)
+    return (return_value == OUT_MEMORY_ERROR) ? OUT_MEMORY_ERROR
+                                              : INVALID_CONFIG_FILE;
+  points[player_turn - 1] += points_won;
+  int move_count = 1;
+  int pass_count = 0;
+  player_turn = (player_turn == player_1) ? player_2 : player_1;
+  while((pass_count < pass_limit) && (move_count < MONTE_CARLO_DEPTH) &&
+        (points[0] < monte_carlo->winning_points_) &&
+        (points[1] < monte_carlo->winning_points_))
+  {
+    FieldMove field_move;
+    return_value = tournamentMove(&rollout_player, game_play_field,
+                                  board_kernels,
+                                  &tournament_board->letter_table_,
+                                  monte_carlo->dictionary_, &no_book,
+                                  points[0], points[1], player_turn,
+                                  random_state, &field_move);
+    if(return_value == OUT_MEMORY_ERROR)
+      break;
+    points_won = 0;
+    if(return_value == SUCCESS)
+      return_value = fieldMakeMove(game_play_field, board_kernels,
+                                   &field_move,
+                                   &tournament_board->letter_table_,
+                                   &points_won, &move_undos[move_count]);
+    if(return_value == OUT_MEMORY_ERROR)
+      break;
+    if(return_value == SUCCESS)
+    {
+      points[player_turn - 1] += points_won;
+      move_count++;
+      pass_count = 0;
+    }
+    else
+      pass_count++;
+    return_value = SUCCESS;
+    player_turn = (player_turn == player_1) ? player_2 : player_1;
+  }
+  monte_carlo_thread->rollout_moves_ += move_count - 1;
+
+  while(move_count > 0)
+  {
+    move_count--;
+    fieldUnmakeMove(game_play_field, board_kernels, &move_undos[move_count]);
+  }
+  int mover_index = monte_carlo->player_turn_ - 1;
+  *margin = points[mover_index] - points[1 - mover_index];
+  return return_value;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function monteCarloThread, we run the next open simulation until
+/// all are done or one failed. The start position is unpacked once into
+/// the field of the thread and every simulation leaves it as it was. The
+/// results go to the thread's own sums, so no lock is needed.
+///
+/// @param thread_argument the MonteCarloThread of the thread.
+///
+/// @return NULL
+//
+void* monteCarloThread(void* thread_argument)
+{
+  MonteCarloThread* monte_carlo_thread = (MonteCarloThread*)thread_argument;
+  MonteCarlo* monte_carlo = monte_carlo_thread->monte_carlo_;
+  const TournamentBoard* tournament_board = monte_carlo->board_;
+  const BoardKernels* board_kernels = &tournament_board->board_kernels_;
+  int field_size = board_kernels->field_size_;
+  int player1_points = 0;
+  int player2_points = 0;
+  int player_turn = 0;
+  monte_carlo_thread->game_play_field_ =
+      board_kernels->create_field_(field_size);
+  int return_value = OUT_MEMORY_ERROR;
+  if(monte_carlo_thread->game_play_field_ != NULL)
+    return_value = decodePackedPosition(
+        tournament_board->packed_, tournament_board->packed_size_,
+        monte_carlo_thread->game_play_field_, board_kernels,
+        &tournament_board->letter_table_, &player1_points, &player2_points,
+        &player_turn);
+
+  int simulation_count =
+      monte_carlo->candidate_count_ * monte_carlo->simulations_;
+  while((return_value == SUCCESS) &&
+        (atomic_load(&monte_carlo->error_) == SUCCESS))
+  {
+    int simulation_index = atomic_fetch_add(&monte_carlo->next_simulation_, 1);
+    if(simulation_index >= simulation_count)
+      break;
+    // every simulation has its own stream, so the results do not depend
+    // on which thread runs it
+    unsigned long long random_state =
+        ((unsigned long long)simulation_index + 1) * ANAGRAM_KEY_SEED;
+    int candidate_index = simulation_index % monte_carlo->candidate_count_;
+    int margin = 0;
+    return_value = simulateMove(monte_carlo, monte_carlo_thread,
+                                candidate_index, &random_state, &margin);
+    if(return_value != SUCCESS)
+      break;
+    monte_carlo_thread->margin_sums_[candidate_index] += margin;
+    if(margin > 0)
+      monte_carlo_thread->wins_[candidate_index]++;
+    monte_carlo_thread->simulations_++;
+  }
+  if(return_value != SUCCESS)
+    atomic_store(&monte_carlo->error_, return_value);
+  if(monte_carlo_thread->game_play_field_ != NULL)
+    board_kernels->free_field_(monte_carlo_thread->game_play_field_,
+                               field_size);
+  monte_carlo_thread->game_play_field_ = NULL;
+  return NULL;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function compareMonteCarloMoves, we sort evaluated moves by their
+/// average margin, the best first.
+///
+/// @param first_move the first MonteCarloMove.
+/// @param second_move the second MonteCarloMove.
+///
+/// @return a negative number if the first move is better, a positive one if
+///         the second is better, 0 otherwise.
+//
+int compareMonteCarloMoves(const void* first_move, const void* second_move)
+{
+  double first_margin = ((const MonteCarloMove*)first_move)->average_margin_;
+  double second_margin =
+      ((const MonteCarloMove*)second_move)->average_margin_;
+  if(first_margin > second_margin)
+    return -1;
+  if(first_margin < second_margin)
+    return 1;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+///
+/// In the function evaluateMoves, we rank the best moves of the player to
+/// move by simulating random continuations of each of them on all
+/// processors. A move is worth the average margin it leads to, which
+/// takes the answers of the other player into account where the points of
+/// the move alone do not.
+///
+/// @param config_name name of the config file.
+/// @param candidate_count the number of best moves to evaluate.
+/// @param simulations the number of simulations per move.
+///
+/// @return CANNOT_OPEN_CONFIG_FILE if a file cannot be opened.
+/// @return INVALID_CONFIG_FILE if the config file is not valid.
+/// @return OUT_MEMORY_ERROR if the memory could not be allocated.
+/// @return SUCCESS otherwise.
+//
+int evaluateMoves(char* config_name, int candidate_count, int simulations)
+{
+  int error_return_value = 1;
+  int orientation_count = 2;
+  double percent = 100.0;
+  MonteCarlo monte_carlo;
+  memset(&monte_carlo, 0, sizeof(MonteCarlo));
+  TournamentBoard tournament_board;
+  Dictionary dictionary;
+  memset(&dictionary, 0, sizeof(Dictionary));
+  int return_value = loadTournamentBoard(config_name, &tournament_board);
+  if(return_value == SUCCESS)
+  {
+    return_value = loadDictionary(DICTIONARY_NAME, &dictionary);
+    if(return_value == CANNOT_OPEN_CONFIG_FILE)
+      printf("Error: Cannot open file: %s\n", DICTIONARY_NAME);
+  }
+  const BoardKernels* board_kernels = &tournament_board.board_kernels_;
+  int field_size = board_kernels->field_size_;
+  Word** game_play_field = NULL;
+  if(return_value == SUCCESS)
+  {
+    game_play_field = board_kernels->create_field_(field_size);
+    if(game_play_field == NULL)
+      return_value = OUT_MEMORY_ERROR;
+  }
+  if(return_value == SUCCESS)
+    return_value = decodePackedPosition(
+        tournament_board.packed_, tournament_board.packed_size_,
+        game_play_field, board_kernels, &tournament_board.letter_table_,
+        &monte_carlo.player1_points_, &monte_carlo.player2_points_,
+        &monte_carlo.player_turn_);
+
+  // the candidates are the best moves by their own points
+  PatternSearch pattern_search;
+  memset(&pattern_search, 0, sizeof(PatternSearch));
+  if(return_value == SUCCESS)
+  {
+    initializePatternSearch(&pattern_search, game_play_field, board_kernels,
+                            &tournament_board.letter_table_, &dictionary,
+                            "*", NULL);
+    pattern_search.move_limit_ = candidate_count;
+  }
+  int line_iterator = 0;
+  for(line_iterator = 0; (return_value == SUCCESS) &&
+      (line_iterator < orientation_count * field_size); line_iterator++)
+    return_value = searchPatternLine(&pattern_search, game_play_field,
+                                     board_kernels, line_iterator / field_size,
+                                     line_iterator % field_size, 0);
+  // the book move is always a candidate, in place of the weakest one
+  OpeningBook opening_book;
+  FieldMove book_move;
+  int book_value = error_return_value;
+  if(return_value == SUCCESS)
+  {
+    openOpeningBook(OPENING_BOOK_NAME, &opening_book);
+    book_value = fieldBookMove(&opening_book, game_play_field, board_kernels,
+                               &tournament_board.letter_table_,
+                               monte_carlo.player1_points_,
+                               monte_carlo.player2_points_,
+                               monte_carlo.player_turn_, &book_move);
+    closeOpeningBook(&opening_book);
+    if(book_value == OUT_MEMORY_ERROR)
+      return_value = OUT_MEMORY_ERROR;
+  }
+  int move_iterator = 0;
+  while((book_value == SUCCESS) &&
+        (move_iterator < pattern_search.move_count_) &&
+        (compareFieldMoves(&pattern_search.moves_[move_iterator],
+                           &book_move) != 0))
+    move_iterator++;
+  if((book_value == SUCCESS) &&
+     (move_iterator == pattern_search.move_count_))
+  {
+    FieldMove* candidate_move =
+        &pattern_search.moves_[pattern_search.worst_move_];
+    if(pattern_search.move_count_ < candidate_count)
+      candidate_move = appendFieldMove(&pattern_search.moves_,
+                                       &pattern_search.move_count_,
+                                       &pattern_search.move_capacity_);
+    if(candidate_move == NULL)
+      return_value = OUT_MEMORY_ERROR;
+    else
+      *candidate_move = book_move;
+  }
+  // a candidate the insert would refuse would stop every simulation of it
+  if(return_value == SUCCESS)
+    return_value = recheckFieldMoves(game_play_field, board_kernels,
+                                     &tournament_board.letter_table_,
+                                     pattern_search.moves_,
+                                     &pattern_search.move_count_);
+  if(game_play_field != NULL)
+    board_kernels->free_field_(game_play_field, field_size);
+  if((return_value == SUCCESS) && (pattern_search.move_count_ == 0))
+  {
+    printf("No move found.\n");
+    return_value = error_return_value;
+  }
+  if(return_value == SUCCESS)
+  {
+    qsort(pattern_search.moves_, pattern_search.move_count_,
+          sizeof(FieldMove), compareFieldMoves);
+    monte_carlo.board_ = &tournament_board;
+    monte_carlo.dictionary_ = &dictionary;
+    monte_carlo.candidates_ = pattern_search.moves_;
+    monte_carlo.candidate_count_ = pattern_search.move_count_;
+    monte_carlo.simulations_ = simulations;
+    monte_carlo.winning_points_ = (field_size * field_size) / 2;
+    atomic_init(&monte_carlo.next_simulation_, 0);
+    atomic_init(&monte_carlo.error_, SUCCESS);
+  }
+
+  long thread_count = sysconf(_SC_NPROCESSORS_ONLN);
+  if(thread_count < 1)
+    thread_count = 1;
+  MonteCarloThread* monte_carlo_threads = NULL;
+  if(return_value == SUCCESS)
+  {
+    monte_carlo_threads = (MonteCarloThread*)calloc(thread_count,
+                                                    sizeof(MonteCarloThread));
+    if(monte_carlo_threads == NULL)
+      return_value = OUT_MEMORY_ERROR;
+  }
+  long thread_iterator = 0;
+  for(thread_iterator = 0;
+      (return_value == SUCCESS) && (thread_iterator < thread_count);
+      thread_iterator++)
+  {
+    MonteCarloThread* monte_carlo_thread =
+        &monte_carlo_threads[thread_iterator];
+    monte_carlo_thread->monte_carlo_ = &monte_carlo;
+    monte_carlo_thread->margin_sums_ =
+        (long*)calloc(monte_carlo.candidate_count_, sizeof(long));
+    monte_carlo_thread->wins_ =
+        (long*)calloc(monte_carlo.candidate_count_, sizeof(long));
+    if((monte_carlo_thread->margin_sums_ == NULL) ||
+       (monte_carlo_thread->wins_ == NULL))
+      return_value = OUT_MEMORY_ERROR;
+  }
+
+  if(return_value == SUCCESS)
+  {
+    double start_time = benchmarkSeconds();
+    long started_threads = 0;
+    while((started_threads < thread_count) &&
+          (pthread_create(&monte_carlo_threads[started_threads].thread_, NULL,
+                          monteCarloThread,
+                          &monte_carlo_threads[started_threads]) == 0))
+      started_threads++;
+    // with no thread at all the simulations are run here
+    if(started_threads == 0)
+      monteCarloThread(&monte_carlo_threads[0]);
+    for(thread_iterator = 0; thread_iterator < started_threads;
+        thread_iterator++)
+      pthread_join(monte_carlo_threads[thread_iterator].thread_, NULL);
+    double elapsed_seconds = benchmarkSeconds() - start_time;
+    return_value = atomic_load(&monte_carlo.error_);
+
+    MonteCarloMove evaluated_moves[MONTE_CARLO_MAX_CANDIDATES];
+    long simulation_total = 0;
+    long rollout_total = 0;
+    int candidate_iterator = 0;
+    for(candidate_iterator = 0;
+        candidate_iterator < monte_carlo.candidate_count_;
+        candidate_iterator++)
+    {
+      long margin_sum = 0;
+      long wins = 0;
+      for(thread_iterator = 0; thread_iterator < thread_count;
+          thread_iterator++)
+      {
+        const MonteCarloThread* monte_carlo_thread =
+            &monte_carlo_threads[thread_iterator];
+        margin_sum += monte_carlo_thread->margin_sums_[candidate_iterator];
+        wins += monte_carlo_thread->wins_[candidate_iterator];
+      }
+      evaluated_moves[candidate_iterator].field_move_ =
+          monte_carlo.candidates_[candidate_iterator];
+      evaluated_moves[candidate_iterator].average_margin_ =
+          (double)margin_sum / simulations;
+      evaluated_moves[candidate_iterator].win_share_ =
+          percent * wins / simulations;
+    }
+    for(thread_iterator = 0; thread_iterator < thread_count;
+        thread_iterator++)
+    {
+      simulation_total += monte_carlo_threads[thread_iterator].simulations_;
+      rollout_total += monte_carlo_threads[thread_iterator].rollout_moves_;
+    }
+    if(return_value == SUCCESS)
+    {
+      qsort(evaluated_moves, monte_carlo.candidate_count_,
+            sizeof(MonteCarloMove), compareMonteCarloMoves);
+      printf("%-6s %7s %7s %9s  %s\n", "Rank", "Points", "Wins", "Margin",
+             "Move");
+      for(candidate_iterator = 0;
+          candidate_iterator < monte_carlo.candidate_count_;
+          candidate_iterator++)
+      {
+        const MonteCarloMove* evaluated_move =
+            &evaluated_moves[candidate_iterator];
+        printf("%-6d %7d %6.1f%% %+9.2f  ", candidate_iterator + 1,
+               evaluated_move->field_move_.points_,
+               evaluated_move->win_share_, evaluated_move->average_margin_);
+        printFieldMove(&evaluated_move->field_move_);
+      }
+      printf("%ld simulations, %ld rollout moves in %.3f s on %ld threads\n",
+             simulation_total, rollout_total, elapsed_seconds, thread_count);
+      printf("%.1f simulations per second\n",
+             elapsed_seconds > 0 ? simulation_total / elapsed_seconds : 0.0);
+    }
+    if(return_value == INVALID_CONFIG_FILE)
+      printf("Error: Invalid file: %s\n", config_name);
+  }
+  if(return_value == OUT_MEMORY_ERROR)
+    printf("Error: Out of memory\n");
+  if(return_value == error_return_value)
+    return_value = SUCCESS;
+
+  for(thread_iterator = 0;
+      (monte_carlo_threads != NULL) && (thread_iterator < thread_count);
+      thread_iterator++)
+  {
+    free(monte_carlo_threads[thread_iterator].margin_sums_);
+    free(monte_carlo_threads[thread_iterator].wins_);
+  }
+  free(monte_carlo_threads);
+  free(pattern_search.moves_);
+  free(tournament_board.packed_);
+  free(tournament_board.char_points_string_);
+  freeDictionary(&dictionary);
+  return return_value;
+}